@@ -0,0 +1,149 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+
+#include "camerastack.h"
+#include "tracker.h"
+#include "kalman_param.h"
+#include "configmanager.h"
+#include "detection_log.h"
+#include "trajectory_log.h"
+#include "mot_metrics.h"
+
+
+using namespace mctracker;
+using namespace mctracker::config;
+using namespace mctracker::utils;
+using namespace mctracker::tracker;
+
+typedef std::map< uint32_t, std::vector<TrajectoryRecord> > Frames;
+
+//the ground truth is a trajectory log or a text file with a line "frame, id, x, y" for each object
+static bool readGroundTruth(const std::string& file, Frames& frames)
+{
+    std::vector<TrajectoryRecord> records;
+    if(!TrajectoryLog::read(file, records))
+    {
+        std::ifstream in(file);
+        if(!in.is_open())
+        {
+            return false;
+        }
+
+        std::string line;
+        while(std::getline(in, line))
+        {
+            if(line.empty() || line.at(0) == '#')
+            {
+                continue;
+            }
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::stringstream ss(line);
+            TrajectoryRecord r;
+            if(ss >> r.frame >> r.label >> r.x >> r.y)
+            {
+                records.push_back(r);
+            }
+        }
+    }
+
+    for(const auto& r : records)
+    {
+        frames[r.frame].push_back(r);
+    }
+    //an empty or unparseable file would score the tracker against nothing
+    return !records.empty();
+}
+
+
+auto main(int argc, char **argv) -> int
+{
+    if(argc != 4 && argc != 5)
+    {
+        std::cout << "Error: too few/much arguments!" << std::endl;
+        std::cout << "Usage: " << argv[0] << " /path/to/the/config/file /path/to/the/detection/log /path/to/the/ground/truth [match threshold]" << std::endl;
+        std::cout << "The ground truth frames are the tracking steps of the detection log, starting from 0" << std::endl;
+        exit(-1);
+    }
+    const float threshold = (argc == 5) ? std::stof(argv[4]) : 50.;
+
+    Frames groundTruth;
+    if(!readGroundTruth(std::string(argv[3]), groundTruth))
+    {
+        std::cout << "Invalid ground truth: " << argv[3] << std::endl;
+        return 1;
+    }
+
+    ConfigManager config;
+    config.read(std::string(argv[1]));
+
+    //the evaluation is reproducible: the input is replayed in deterministic mode
+    auto param = config.getKalmanParam();
+    param.setDeterministic(true);
+    param.setDetectionLog("");
+    param.setTrajectoryLog("");
+
+    CameraStack streams(config.getCameraParam());
+    Tracker tr(param, streams.getCameraStack());
+
+    DetectionLog log;
+    log.open(std::string(argv[2]));
+
+    MotMetrics metrics(threshold);
+    std::vector<Detections> observations;
+    std::vector<double> timestamps;
+    std::vector<TrajectoryRecord> hyp;
+    const std::vector<TrajectoryRecord> empty;
+    double ticks = 0;
+    uint frames = 0;
+    int w, h;
+    while(log.read(observations, timestamps, w, h))
+    {
+        tr.setSize(w, h);
+
+        //only the tracking step is timed
+        const int64 start = cv::getTickCount();
+        if(timestamps.size() == 1)
+        {
+            tr.track(observations, w, h, timestamps.at(0));
+        }
+        else
+        {
+            tr.track(observations, w, h, timestamps);
+        }
+        ticks += cv::getTickCount() - start;
+        ++frames;
+
+        //the tracks which are not confirmed yet are not part of the output
+        const auto& snapshot = tr.getSnapshot();
+        hyp.clear();
+        for(const auto& state : snapshot->states())
+        {
+            if(state.good)
+            {
+                TrajectoryRecord r;
+                r.label = state.label;
+                r.frame = uint32_t(snapshot->frame());
+                r.x = state.x;
+                r.y = state.y;
+                hyp.push_back(r);
+            }
+        }
+
+        const auto& gt = groundTruth.find(uint32_t(snapshot->frame()));
+        metrics.update((gt != groundTruth.end()) ? gt->second : empty, hyp);
+    }
+    metrics.finalize();
+
+    const double& seconds = ticks / cv::getTickFrequency();
+    std::cout << "{" << std::endl;
+    std::cout << "  \"fps\": " << ((seconds > 0) ? frames / seconds : 0.) << "," << std::endl;
+    std::cout << "  \"ms_per_frame\": " << ((frames > 0) ? seconds * 1000. / frames : 0.) << "," << std::endl;
+    metrics.toJson(std::cout);
+    std::cout << std::endl << "}" << std::endl;
+
+    return 0;
+}
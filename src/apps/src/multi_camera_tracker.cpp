@@ -2,6 +2,7 @@
 #include <opencv2/opencv.hpp>
 
 #include "object_detector.h"
+#include "detection_scheduler.h"
 #include "camerastack.h"
 #include "bgsubtraction.h"
 #include "track.h"
@@ -11,6 +12,7 @@
 #include "configmanager.h"
 #include "homography.h"
 #include "utility.h"
+#include "threadpool.h"
 
 
 using namespace mctracker;
@@ -39,67 +41,188 @@ auto main(int argc, char **argv) -> int
     //initialize all the main objects
     CameraStack streams(config.getCameraParam());
     ObjectDetector detector(config.getDetectorParam());
-    std::vector<BgSubtraction> bgSub(config.getCameraNumber());
+    std::vector<BgSubtraction> bgSub;
+    for(auto i = 0; i < config.getCameraNumber(); ++i)
+    {
+        bgSub.push_back(BgSubtraction(config.getSegmentationParam()));
+    }
     Tracker tr(config.getKalmanParam(), streams.getCameraStack());
+    std::vector<DetectionScheduler> schedulers;
+    for(const auto& param : config.getCameraParam())
+    {
+        schedulers.push_back(DetectionScheduler(param.getDetectionInterval(), param.getMotionThreshold(), 
+                                                config.getDetectorParam().getRoiMinArea()));
+    }
     
     //set tracker space
     tr.setSize(w, h);
     
+    //one worker for each camera
+    ThreadPool pool(config.getCameraNumber());
+    
+    //frame of a camera waiting for its detections
+    struct PendingFrame
+    {
+        cv::Mat frame;
+        cv::Mat fgMask;
+        std::vector<bbox_t> blobs;
+        bool submitted;
+        double timestamp;
+    };
+    
     //storing variables
-    std::vector<cv::Mat> frames;
-    std::vector<cv::Mat> detectionFrames(config.getCameraNumber());
     std::vector<cv::Mat> trackingFrames(config.getCameraNumber());
-    std::vector<cv::Mat> fgMasks(config.getCameraNumber());
-    std::vector< std::vector<bbox_t> > detections(config.getCameraNumber());
-    bool compute = false;
+    std::vector<Detections> observations(config.getCameraNumber());
+    std::vector<double> timestamps(config.getCameraNumber());
+    std::vector<PendingFrame> current(config.getCameraNumber()), previous(config.getCameraNumber());
+    std::vector< std::future<bool> > results;
+    bool compute = false, pending = false;
+    uint64_t frameId = 0;
     cv::Mat imageTracks;
     
     auto& cameras = streams.getCameraStack();
     
-    while(streams.getFrame(frames))
+    //track a set of frames once the detector has returned their detections
+    auto track_frames = [&](std::vector<PendingFrame>& set, const uint64_t& id)
     {
         imageTracks = config.getPlaview().clone();
         
-        std::stringstream ss;
-        auto i = 0;
+        results.clear();
+        for(auto i = 0; i < int(set.size()); ++i)
+        {
+            results.push_back(pool.enqueue([&, i]()
+            {
+                auto& p = set.at(i);
+                ObjectDetector::Result r;
+                if(p.submitted && detector.poll(i, id, r))
+                {
+                    //a stale result keeps the frame and the time it was computed on: it gets an out-of-sequence update
+                    observations.at(i) = Utility::dets2Obs(r.dets, r.image, r.fgMask, cameras.at(i));
+                    timestamps.at(i) = r.timestamp;
+                }
+                else
+                {
+                    observations.at(i) = Utility::dets2Obs(p.blobs, p.frame, p.fgMask, cameras.at(i));
+                    timestamps.at(i) = p.timestamp;
+                }
+                trackingFrames.at(i) = p.frame;
+                return true;
+            }));
+        }
+        
+        for(auto& result : results)
+        {
+            result.get();
+        }
+        
+        //the cameras are not synchronised: the late observations get an out-of-sequence update
+        tr.track(observations, w, h, timestamps);
+        
+        //the drawing only reads the published snapshot, not the live tracks
+        const auto& snapshot = tr.getSnapshot();
+        snapshot->draw(trackingFrames, cameras);
+        if(config.showPlanView())
+        {
+            snapshot->drawPlanView(imageTracks);
+        }
+        
+        cv::imshow("TRACKING", Utility::makeMosaic(trackingFrames));
+        if(config.showPlanView())
+            cv::imshow("TRACKS", imageTracks);
         
-        for(const auto& frame : frames)
+        cv::waitKey(1);
+    };
+    
+    //the frames are grabbed sequentially and converted by each camera worker
+    while(streams.grab())
+    {
+        //segmentation of each camera runs concurrently, the detector is only fed with the frames
+        results.clear();
+        for(auto i = 0; i < config.getCameraNumber(); ++i)
         {
-            detectionFrames.at(i) = frame.clone();
-            trackingFrames.at(i) = frame.clone();
-            cv::Mat fgMask;
-            bgSub.at(i).process(frame);
-            compute = bgSub.at(i).getFgMask(fgMask);
-            if(compute)
+            results.push_back(pool.enqueue([&, i]()
             {
-                fgMasks.at(i) = fgMask.clone();
-                detector.classify(detectionFrames.at(i), false);
-                detections.at(i) = detector.detections();
-            }
-            i++;
+                auto& p = current.at(i);
+                p.blobs.clear();
+                p.submitted = false;
+                if(!streams.retrieve(i, p.frame))
+                {
+                    return false;
+                }
+                p.timestamp = streams.timestamp(i);
+                
+                bgSub.at(i).process(p.frame);
+                if(!bgSub.at(i).getFgMask(p.fgMask))
+                {
+                    return false;
+                }
+                
+                if(schedulers.at(i).schedule(p.fgMask))
+                {
+                    //the colors are converted only for the detection frames
+                    if(cameras.at(i).isGray())
+                    {
+                        streams.retrieve(i, p.frame, true);
+                    }
+                    p.submitted = detector.submit(i, frameId, p.timestamp, p.frame, p.fgMask);
+                    //a request rejected for the requests in flight is not a run of the detector
+                    schedulers.at(i).report(p.submitted);
+                }
+                
+                if(!p.submitted)
+                {
+                    //between two runs of the detector the foreground blobs keep the tracks alive
+                    p.blobs = schedulers.at(i).blobs(p.fgMask, p.frame.size());
+                    if(p.frame.channels() == 1)
+                    {
+                        cv::cvtColor(p.frame, p.frame, cv::COLOR_GRAY2BGR);
+                    }
+                }
+                return true;
+            }));
         }
         
-        if(compute)
+        //barrier: the tracker needs the observations of all the cameras
+        compute = true;
+        for(auto& result : results)
         {
-            auto observations = 
-                Utility::dets2Obs(detections, frames, fgMasks, cameras);
-            
-            tr.track(observations, w, h);
-            
-            const auto& tracks = tr.getTracks();
-            for(auto& track : tracks)
+            compute &= result.get();
+        }
+        
+        //the frames are not tracked: the requests of the other cameras would hold their slots until they get stale
+        if(!compute)
+        {
+            for(auto i = 0; i < config.getCameraNumber(); ++i)
             {
-                track->drawTrack(trackingFrames, cameras);
-                if(config.showPlanView())
-                    track->drawTrackPlanView(imageTracks);
+                if(current.at(i).submitted)
+                {
+                    detector.cancel(i, frameId);
+                }
             }
-            
-            cv::imshow("TRACKING", Utility::makeMosaic(trackingFrames));
-            if(config.showPlanView())
-                cv::imshow("TRACKS", imageTracks);
-            
-            cv::waitKey(1);
         }
+        
+        //the previous frames are tracked while the current ones are in inference
+        if(pending)
+        {
+            track_frames(previous, frameId - 1);
+        }
+        
+        std::swap(current, previous);
+        pending = compute;
+        ++frameId;
+    }
+    
+    //flush the last frames
+    if(pending)
+    {
+        track_frames(previous, frameId - 1);
+    }
+    
+    for(auto i = 0; i < int(schedulers.size()); ++i)
+    {
+        std::cout << "CAMERA " << i+1 << " [DETECTOR DUTY CYCLE]: " << schedulers.at(i).dutyCycle() << std::endl;
+        std::cout << "CAMERA " << i+1 << " [" << bgSub.at(i).engine() << " COST]: " << bgSub.at(i).getMeanCost() << " ms" << std::endl;
     }
+    TrackPool::instance()->print();
     return 0;
 }
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <cstring>
+#include <opencv2/opencv.hpp>
+
+#include "camerastack.h"
+#include "tracker.h"
+#include "kalman_param.h"
+#include "configmanager.h"
+#include "detection_log.h"
+#include "trajectory_log.h"
+
+
+using namespace mctracker;
+using namespace mctracker::config;
+using namespace mctracker::utils;
+using namespace mctracker::tracker;
+
+
+auto main(int argc, char **argv) -> int
+{
+    if(argc != 4 && !(argc == 5 && std::string(argv[4]) == "--record"))
+    {
+        std::cout << "Error: too few/much arguments!" << std::endl;
+        std::cout << "Usage: " << argv[0] << " /path/to/the/config/file /path/to/the/detection/log /path/to/the/golden/output [--record]" << std::endl;
+        std::cout << "The detection log is recorded by multi_camera_tracker with the DETECTIONLOG key of the kalman parameters" << std::endl;
+        exit(-1);
+    }
+    const bool record = (argc == 5);
+
+    ConfigManager config;
+    config.read(std::string(argv[1]));
+
+    //the replay is always deterministic and does not record anything
+    auto param = config.getKalmanParam();
+    param.setDeterministic(true);
+    param.setDetectionLog("");
+    param.setTrajectoryLog("");
+
+    CameraStack streams(config.getCameraParam());
+    Tracker tr(param, streams.getCameraStack());
+
+    DetectionLog log;
+    log.open(std::string(argv[2]));
+
+    //replay the recorded input and collect the state of the tracks after each step
+    std::vector<Detections> observations;
+    std::vector<double> timestamps;
+    std::vector<TrajectoryRecord> output;
+    int w, h;
+    while(log.read(observations, timestamps, w, h))
+    {
+        tr.setSize(w, h);
+        if(timestamps.size() == 1)
+        {
+            tr.track(observations, w, h, timestamps.at(0));
+        }
+        else
+        {
+            tr.track(observations, w, h, timestamps);
+        }
+
+        const auto& snapshot = tr.getSnapshot();
+        for(const auto& state : snapshot->states())
+        {
+            TrajectoryRecord r;
+            r.label = state.label;
+            r.frame = uint32_t(snapshot->frame());
+            r.x = state.x;
+            r.y = state.y;
+            output.push_back(r);
+        }
+    }
+
+    if(record)
+    {
+        TrajectoryLog::save(std::string(argv[3]), output);
+        std::cout << "[REPLAY]: " << output.size() << " track states stored in " << argv[3] << std::endl;
+        return 0;
+    }
+
+    std::vector<TrajectoryRecord> golden;
+    if(!TrajectoryLog::read(std::string(argv[3]), golden))
+    {
+        std::cout << "Invalid golden output: " << argv[3] << std::endl;
+        return 1;
+    }
+
+    //ids and positions have to match bit for bit
+    const auto& size = std::min(output.size(), golden.size());
+    for(size_t i = 0; i < size; ++i)
+    {
+        if(std::memcmp(&output.at(i), &golden.at(i), sizeof(TrajectoryRecord)) != 0)
+        {
+            const auto& e = golden.at(i);
+            const auto& g = output.at(i);
+            std::cout << "[REPLAY]: FAILED at frame " << g.frame << std::endl;
+            std::cout << "    expected: #" << e.label << " (" << e.x << ", " << e.y << ") at frame " << e.frame << std::endl;
+            std::cout << "    got:      #" << g.label << " (" << g.x << ", " << g.y << ") at frame " << g.frame << std::endl;
+            return 1;
+        }
+    }
+
+    if(output.size() != golden.size())
+    {
+        std::cout << "[REPLAY]: FAILED, " << output.size() << " track states instead of " << golden.size() << std::endl;
+        return 1;
+    }
+
+    std::cout << "[REPLAY]: PASSED, " << output.size() << " track states match the golden output" << std::endl;
+    return 0;
+}
@@ -99,6 +99,98 @@ namespace mctracker
                     return proximity;
                 }
                 
+                /**
+                 * @brief set the number of frames between two runs of the detector
+                 * @param interval the number of frames
+                 */
+                void
+                setDetectionInterval(const int& interval)
+                {
+                    detectionInterval = interval;
+                }
+                
+                /**
+                 * @brief get the number of frames between two runs of the detector
+                 * @return the number of frames
+                 */
+                inline const int
+                getDetectionInterval() const
+                {
+                    return detectionInterval;
+                }
+                
+                /**
+                 * @brief set the change of the motion energy which forces a run of the detector
+                 * @param thresh the change of the foreground ratio
+                 */
+                void
+                setMotionThreshold(const float& thresh)
+                {
+                    motionThreshold = thresh;
+                }
+                
+                /**
+                 * @brief get the change of the motion energy which forces a run of the detector
+                 * @return the change of the foreground ratio
+                 */
+                inline const float
+                getMotionThreshold() const
+                {
+                    return motionThreshold;
+                }
+                
+                /**
+                 * @brief set the resolution at which the frames are decoded
+                 * @param w the width of the frames, 0 means the native resolution
+                 * @param h the height of the frames, 0 means the native resolution
+                 */
+                void
+                setResolution(const int& w, const int& h)
+                {
+                    width = w;
+                    height = h;
+                }
+                
+                /**
+                 * @brief get the width at which the frames are decoded
+                 * @return the width, 0 means the native resolution
+                 */
+                inline const int
+                getWidth() const
+                {
+                    return width;
+                }
+                
+                /**
+                 * @brief get the height at which the frames are decoded
+                 * @return the height, 0 means the native resolution
+                 */
+                inline const int
+                getHeight() const
+                {
+                    return height;
+                }
+                
+                /**
+                 * @brief set the pixel format of the decoded frames
+                 * @param f a string containing the format (BGR or GRAY)
+                 */
+                void
+                setFormat(const std::string& f)
+                {
+                    format = f;
+                }
+                
+                /**
+                 * @brief get the pixel format of the decoded frames
+                 * @return a string containing the format (BGR or GRAY)
+                 */
+                inline const std::string
+                getFormat() const
+                {
+                    return format;
+                }
+                
                 /**
                  * @brief copy operator
                  * @param _param object to copy
@@ -110,6 +202,11 @@ namespace mctracker
                     homography = _param.getHomography();
                     fieldOfView = _param.getFOV();
                     proximity = _param.getProximity();
+                    detectionInterval = _param.getDetectionInterval();
+                    motionThreshold = _param.getMotionThreshold();
+                    width = _param.getWidth();
+                    height = _param.getHeight();
+                    format = _param.getFormat();
                     return *this;
                 }
                 
@@ -123,6 +220,10 @@ namespace mctracker
                     std::cout << "[HOMOGRAPHY]: " << homography << std::endl;
                     std::cout << "[FOV]: " << fieldOfView << std::endl;
                     std::cout << "[PROXIMITY]: " << proximity << std::endl;
+                    std::cout << "[DETECTION INTERVAL]: " << detectionInterval << std::endl;
+                    std::cout << "[MOTION THRESHOLD]: " << motionThreshold << std::endl;
+                    std::cout << "[RESOLUTION]: " << width << "x" << height << std::endl;
+                    std::cout << "[FORMAT]: " << format << std::endl;
                 }
                 
             private:
@@ -130,6 +231,10 @@ namespace mctracker
                 std::string homography;
                 std::string fieldOfView;
                 bool proximity;
+                int detectionInterval;
+                float motionThreshold;
+                int width, height;
+                std::string format;
         };
     }
 }
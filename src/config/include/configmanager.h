@@ -12,6 +12,7 @@
 #include "detector_param.h"
 #include "camera_param.h"
 #include "kalman_param.h"
+#include "segmentation_param.h"
 #include "yamlmanager.h"
 
 namespace mctracker
@@ -67,6 +68,16 @@ namespace mctracker
                     return detectorParam;
                 }
                 
+                /**
+                 * @brief get the segmentation parameters specified in the configuration file
+                 * @return the segmentation parameters specified in the configuration file
+                 */
+                inline const SegmentationParam 
+                getSegmentationParam() const
+                {
+                    return segmentationParam;
+                }
+                
                 /**
                  * @brief get the camera parameters specified in the configuration file
                  * @return the camera parameters specified in the configuration file
@@ -105,6 +116,7 @@ namespace mctracker
             private:
                 KalmanParam kalmanParam;
                 DetectorParam detectorParam;
+                SegmentationParam segmentationParam;
                 std::vector<CameraParam> cameraParam;
                 YamlManager yamlManager;
                 cv::Mat planView;
@@ -77,6 +77,146 @@ namespace mctracker
                     return minThreshold;
                 }
                 
+                /**
+                 * @brief enable the detection on the foreground regions only
+                 * @param r boolean which if is true the detector runs only on the tiles containing the foreground
+                 */
+                void
+                setRoi(const bool& r)
+                {
+                    roi = r;
+                }
+                
+                /**
+                 * @brief get if the detection runs on the foreground regions only
+                 * @return true if the detector runs only on the tiles containing the foreground, false otherwise
+                 */
+                inline const bool
+                getRoi() const
+                {
+                    return roi;
+                }
+                
+                /**
+                 * @brief set the maximum number of tiles on which the detector runs
+                 * @param tiles the maximum number of tiles
+                 */
+                void
+                setRoiMaxTiles(const int& tiles)
+                {
+                    roiMaxTiles = tiles;
+                }
+                
+                /**
+                 * @brief get the maximum number of tiles on which the detector runs
+                 * @return the maximum number of tiles
+                 */
+                inline const int
+                getRoiMaxTiles() const
+                {
+                    return roiMaxTiles;
+                }
+                
+                /**
+                 * @brief set the minimum area of a foreground region for being considered
+                 * @param area the minimum area in pixels
+                 */
+                void
+                setRoiMinArea(const int& area)
+                {
+                    roiMinArea = area;
+                }
+                
+                /**
+                 * @brief get the minimum area of a foreground region for being considered
+                 * @return the minimum area in pixels
+                 */
+                inline const int
+                getRoiMinArea() const
+                {
+                    return roiMinArea;
+                }
+                
+                /**
+                 * @brief set the padding added around each foreground region
+                 * @param padding the padding in pixels
+                 */
+                void
+                setRoiPadding(const int& padding)
+                {
+                    roiPadding = padding;
+                }
+                
+                /**
+                 * @brief get the padding added around each foreground region
+                 * @return the padding in pixels
+                 */
+                inline const int
+                getRoiPadding() const
+                {
+                    return roiPadding;
+                }
+                
+                /**
+                 * @brief set the number of detector contexts (networks) which can run at the same time
+                 * @param c the number of contexts
+                 */
+                void
+                setContexts(const int& c)
+                {
+                    contexts = c;
+                }
+                
+                /**
+                 * @brief get the number of detector contexts (networks) which can run at the same time
+                 * @return the number of contexts
+                 */
+                inline const int
+                getContexts() const
+                {
+                    return contexts;
+                }
+                
+                /**
+                 * @brief set the maximum number of asynchronous requests in flight for each camera
+                 * @param n the maximum number of requests
+                 */
+                void
+                setMaxInFlight(const int& n)
+                {
+                    maxInFlight = n;
+                }
+                
+                /**
+                 * @brief get the maximum number of asynchronous requests in flight for each camera
+                 * @return the maximum number of requests
+                 */
+                inline const int
+                getMaxInFlight() const
+                {
+                    return maxInFlight;
+                }
+                
+                /**
+                 * @brief set how many frames old a result can be for being used instead of waiting the current one
+                 * @param n the number of frames, 0 means that the result of the requested frame is always awaited
+                 */
+                void
+                setMaxStaleFrames(const int& n)
+                {
+                    maxStaleFrames = n;
+                }
+                
+                /**
+                 * @brief get how many frames old a result can be for being used instead of waiting the current one
+                 * @return the number of frames
+                 */
+                inline const int
+                getMaxStaleFrames() const
+                {
+                    return maxStaleFrames;
+                }
+                
                 /**
                  * @brief copy operator
                  * @param _param object to copy
@@ -87,6 +227,13 @@ namespace mctracker
                     config = _param.getConfig();
                     weights = _param.getWeights();
                     minThreshold = _param.getThreshold();
+                    roi = _param.getRoi();
+                    roiMaxTiles = _param.getRoiMaxTiles();
+                    roiMinArea = _param.getRoiMinArea();
+                    roiPadding = _param.getRoiPadding();
+                    contexts = _param.getContexts();
+                    maxInFlight = _param.getMaxInFlight();
+                    maxStaleFrames = _param.getMaxStaleFrames();
                     return *this;
                 }
                 
@@ -99,12 +246,29 @@ namespace mctracker
                     std::cout << "[CONFIG]: " << config << std::endl;
                     std::cout << "[WEIGHTS]: " << weights << std::endl;
                     std::cout << "[THRESHOLD]: " << minThreshold << std::endl;
+                    std::cout << "[ROI]: " << roi << std::endl;
+                    if(roi)
+                    {
+                        std::cout << "[ROI MAX TILES]: " << roiMaxTiles << std::endl;
+                        std::cout << "[ROI MIN AREA]: " << roiMinArea << std::endl;
+                        std::cout << "[ROI PADDING]: " << roiPadding << std::endl;
+                    }
+                    std::cout << "[CONTEXTS]: " << contexts << std::endl;
+                    std::cout << "[MAX IN FLIGHT]: " << maxInFlight << std::endl;
+                    std::cout << "[MAX STALE FRAMES]: " << maxStaleFrames << std::endl;
                 }
                 
             private:
                 std::string config;
                 std::string weights;
                 float minThreshold;
+                bool roi;
+                int roiMaxTiles;
+                int roiMinArea;
+                int roiPadding;
+                int contexts;
+                int maxInFlight;
+                int maxStaleFrames;
         };
     }
 }
@@ -122,6 +122,487 @@ namespace mctracker
                     return max_missed;
                 }
                 
+                /**
+                 * @brief set the gating radius used for fusing the detections coming from different cameras
+                 * @param radius float containing the radius in plan view units
+                 */
+                void
+                setFusionRadius(const float& radius)
+                {
+                    fusion_radius = radius;
+                }
+                
+                /**
+                 * @brief get the gating radius used for fusing the detections coming from different cameras
+                 * @return the radius in plan view units
+                 */
+                inline const float 
+                getFusionRadius() const
+                {
+                    return fusion_radius;
+                }
+                
+                /**
+                 * @brief set the frame rate at which dt is defined, the timestamps are converted to dt according to it
+                 * @param f float containing the frame rate
+                 */
+                void
+                setFps(const float& f)
+                {
+                    fps = f;
+                }
+                
+                /**
+                 * @brief get the frame rate at which dt is defined
+                 * @return the frame rate
+                 */
+                inline const float
+                getFps() const
+                {
+                    return fps;
+                }
+                
+                /**
+                 * @brief set the number of positions kept in the history of each track
+                 * @param length the number of positions
+                 */
+                void
+                setHistory(const uint& length)
+                {
+                    history = length;
+                }
+                
+                /**
+                 * @brief get the number of positions kept in the history of each track
+                 * @return the number of positions
+                 */
+                inline const uint
+                getHistory() const
+                {
+                    return history;
+                }
+                
+                /**
+                 * @brief set the file where the positions dropped from the history are stored
+                 * @param file string containing the path, empty for disabling the log
+                 */
+                void
+                setTrajectoryLog(const std::string& file)
+                {
+                    trajectory_log = file;
+                }
+                
+                /**
+                 * @brief get the file where the positions dropped from the history are stored
+                 * @return string containing the path, empty if the log is disabled
+                 */
+                inline const std::string
+                getTrajectoryLog() const
+                {
+                    return trajectory_log;
+                }
+                
+                /**
+                 * @brief set the file where the input of the tracker is recorded for replaying it
+                 * @param file string containing the path, empty for disabling the recording
+                 */
+                void
+                setDetectionLog(const std::string& file)
+                {
+                    detection_log = file;
+                }
+                
+                /**
+                 * @brief get the file where the input of the tracker is recorded
+                 * @return string containing the path, empty if the recording is disabled
+                 */
+                inline const std::string
+                getDetectionLog() const
+                {
+                    return detection_log;
+                }
+                
+                /**
+                 * @brief enable the deterministic mode: the time of the tracks comes from the timestamps of the frames 
+                 * and not from the wall clock
+                 * @param enable bool, true for enabling the deterministic mode
+                 */
+                void
+                setDeterministic(const bool& enable)
+                {
+                    deterministic = enable;
+                }
+                
+                /**
+                 * @brief check if the deterministic mode is enabled
+                 * @return true if the deterministic mode is enabled
+                 */
+                inline const bool
+                isDeterministic() const
+                {
+                    return deterministic;
+                }
+                
+                /**
+                 * @brief set the seed of the random generator of the tracker
+                 * @param _seed the seed
+                 */
+                void
+                setSeed(const uint& _seed)
+                {
+                    seed = _seed;
+                }
+                
+                /**
+                 * @brief get the seed of the random generator of the tracker
+                 * @return the seed
+                 */
+                inline const uint
+                getSeed() const
+                {
+                    return seed;
+                }
+                
+                /**
+                 * @brief set the data association method of the tracker
+                 * @param method string containing the method: GNN (single best assignment), MHT (multiple hypotheses) or JPDA (joint probabilistic)
+                 */
+                void
+                setAssociation(const std::string& method)
+                {
+                    association = method;
+                }
+                
+                /**
+                 * @brief get the data association method of the tracker
+                 * @return string containing the method
+                 */
+                inline const std::string
+                getAssociation() const
+                {
+                    return association;
+                }
+                
+                /**
+                 * @brief set the number of assignment hypotheses kept by the multiple hypothesis tracker
+                 * @param k the number of hypotheses
+                 */
+                void
+                setMhtHypotheses(const uint& k)
+                {
+                    mht_hypotheses = k;
+                }
+                
+                /**
+                 * @brief get the number of assignment hypotheses kept by the multiple hypothesis tracker
+                 * @return the number of hypotheses
+                 */
+                inline const uint
+                getMhtHypotheses() const
+                {
+                    return mht_hypotheses;
+                }
+                
+                /**
+                 * @brief set the depth of the N-scan pruning: the decisions older than this number of frames are final
+                 * @param scan the number of frames
+                 */
+                void
+                setMhtScan(const uint& scan)
+                {
+                    mht_scan = scan;
+                }
+                
+                /**
+                 * @brief get the depth of the N-scan pruning
+                 * @return the number of frames
+                 */
+                inline const uint
+                getMhtScan() const
+                {
+                    return mht_scan;
+                }
+                
+                /**
+                 * @brief set the probability that a target is detected, used by the joint probabilistic data association
+                 * @param pd the detection probability, in (0, 1)
+                 */
+                void
+                setJpdaPd(const float& pd)
+                {
+                    jpda_pd = pd;
+                }
+                
+                /**
+                 * @brief get the probability that a target is detected
+                 * @return the detection probability
+                 */
+                inline const float
+                getJpdaPd() const
+                {
+                    return jpda_pd;
+                }
+                
+                /**
+                 * @brief set the density of the false detections on the plan view, used by the joint probabilistic data association
+                 * @param clutter the number of false detections for each unit of area
+                 */
+                void
+                setJpdaClutter(const float& clutter)
+                {
+                    jpda_clutter = clutter;
+                }
+                
+                /**
+                 * @brief get the density of the false detections on the plan view
+                 * @return the number of false detections for each unit of area
+                 */
+                inline const float
+                getJpdaClutter() const
+                {
+                    return jpda_clutter;
+                }
+                
+                /**
+                 * @brief set the maximum number of joint events enumerated for a cluster, the bigger clusters are approximated
+                 * @param events the number of joint events
+                 */
+                void
+                setJpdaEvents(const uint& events)
+                {
+                    jpda_events = events;
+                }
+                
+                /**
+                 * @brief get the maximum number of joint events enumerated for a cluster
+                 * @return the number of joint events
+                 */
+                inline const uint
+                getJpdaEvents() const
+                {
+                    return jpda_events;
+                }
+                
+                /**
+                 * @brief set the motion model of the tracks
+                 * @param model string containing the model: CV (constant velocity) or IMM (interacting multiple models)
+                 */
+                void
+                setMotionModel(const std::string& model)
+                {
+                    motion_model = model;
+                }
+                
+                /**
+                 * @brief get the motion model of the tracks
+                 * @return string containing the model
+                 */
+                inline const std::string
+                getMotionModel() const
+                {
+                    return motion_model;
+                }
+                
+                /**
+                 * @brief set the probability that a track keeps its motion model between two frames
+                 * @param stay the probability, in (0, 1)
+                 */
+                void
+                setImmStay(const float& stay)
+                {
+                    imm_stay = stay;
+                }
+                
+                /**
+                 * @brief get the probability that a track keeps its motion model between two frames
+                 * @return the probability
+                 */
+                inline const float
+                getImmStay() const
+                {
+                    return imm_stay;
+                }
+                
+                /**
+                 * @brief set the turn rate of the coordinated-turn models
+                 * @param rate the turn rate in radians per frame, 0 disables the models
+                 */
+                void
+                setImmTurnRate(const float& rate)
+                {
+                    imm_turn_rate = rate;
+                }
+                
+                /**
+                 * @brief get the turn rate of the coordinated-turn models
+                 * @return the turn rate in radians per frame
+                 */
+                inline const float
+                getImmTurnRate() const
+                {
+                    return imm_turn_rate;
+                }
+                
+                /**
+                 * @brief set the number of lost identities kept for the re-identification
+                 * @param size the number of identities, 0 disables the re-identification
+                 */
+                void
+                setReidGallery(const uint& size)
+                {
+                    reid_gallery = size;
+                }
+                
+                /**
+                 * @brief get the number of lost identities kept for the re-identification
+                 * @return the number of identities
+                 */
+                inline const uint
+                getReidGallery() const
+                {
+                    return reid_gallery;
+                }
+                
+                /**
+                 * @brief set the time after which a lost identity cannot be revived
+                 * @param ttl the time in seconds
+                 */
+                void
+                setReidTtl(const float& ttl)
+                {
+                    reid_ttl = ttl;
+                }
+                
+                /**
+                 * @brief get the time after which a lost identity cannot be revived
+                 * @return the time in seconds
+                 */
+                inline const float
+                getReidTtl() const
+                {
+                    return reid_ttl;
+                }
+                
+                /**
+                 * @brief set the minimum appearance similarity for reviving a lost identity
+                 * @param thresh the similarity, in (0, 1]
+                 */
+                void
+                setReidThresh(const float& thresh)
+                {
+                    reid_thresh = thresh;
+                }
+                
+                /**
+                 * @brief get the minimum appearance similarity for reviving a lost identity
+                 * @return the similarity
+                 */
+                inline const float
+                getReidThresh() const
+                {
+                    return reid_thresh;
+                }
+                
+                /**
+                 * @brief set the maximum speed of a lost identity, a new track farther than it could have walked cannot revive it
+                 * @param speed the speed in plan view pixels per second
+                 */
+                void
+                setReidSpeed(const float& speed)
+                {
+                    reid_speed = speed;
+                }
+                
+                /**
+                 * @brief get the maximum speed of a lost identity
+                 * @return the speed in plan view pixels per second
+                 */
+                inline const float
+                getReidSpeed() const
+                {
+                    return reid_speed;
+                }
+                
+                /**
+                 * @brief set the number of links of each node of the appearance index, more links give a higher recall and a slower insertion
+                 * @param links the number of links
+                 */
+                void
+                setAnnLinks(const uint& links)
+                {
+                    ann_links = links;
+                }
+                
+                /**
+                 * @brief get the number of links of each node of the appearance index
+                 * @return the number of links
+                 */
+                inline const uint
+                getAnnLinks() const
+                {
+                    return ann_links;
+                }
+                
+                /**
+                 * @brief set the size of the candidate list used for inserting into the appearance index
+                 * @param ef the size of the list
+                 */
+                void
+                setAnnEfConstruction(const uint& ef)
+                {
+                    ann_ef_construction = ef;
+                }
+                
+                /**
+                 * @brief get the size of the candidate list used for inserting into the appearance index
+                 * @return the size of the list
+                 */
+                inline const uint
+                getAnnEfConstruction() const
+                {
+                    return ann_ef_construction;
+                }
+                
+                /**
+                 * @brief set the size of the candidate list of the appearance queries: bigger lists give a higher recall and a higher latency
+                 * @param ef the size of the list
+                 */
+                void
+                setAnnEfSearch(const uint& ef)
+                {
+                    ann_ef_search = ef;
+                }
+                
+                /**
+                 * @brief get the size of the candidate list of the appearance queries
+                 * @return the size of the list
+                 */
+                inline const uint
+                getAnnEfSearch() const
+                {
+                    return ann_ef_search;
+                }
+                
+                /**
+                 * @brief set the number of most similar frozen tracks whose appearance is compared with each detection
+                 * @param neighbors the number of tracks, 0 compares all of them
+                 */
+                void
+                setAnnNeighbors(const uint& neighbors)
+                {
+                    ann_neighbors = neighbors;
+                }
+                
+                /**
+                 * @brief get the number of most similar frozen tracks whose appearance is compared with each detection
+                 * @return the number of tracks, 0 if all of them are compared
+                 */
+                inline const uint
+                getAnnNeighbors() const
+                {
+                    return ann_neighbors;
+                }
+                
                 /**
                  * @brief copy operator
                  * @param _param object to copy
@@ -134,6 +615,30 @@ namespace mctracker
                     this->assoc_dummy_cost = _param.getAssocdummycost();
                     this->new_hyp_dummy_cost = _param.getNewhypdummycost();
                     this->max_missed = _param.getMaxmissed();
+                    this->fusion_radius = _param.getFusionRadius();
+                    this->fps = _param.getFps();
+                    this->history = _param.getHistory();
+                    this->trajectory_log = _param.getTrajectoryLog();
+                    this->detection_log = _param.getDetectionLog();
+                    this->deterministic = _param.isDeterministic();
+                    this->seed = _param.getSeed();
+                    this->association = _param.getAssociation();
+                    this->mht_hypotheses = _param.getMhtHypotheses();
+                    this->mht_scan = _param.getMhtScan();
+                    this->jpda_pd = _param.getJpdaPd();
+                    this->jpda_clutter = _param.getJpdaClutter();
+                    this->jpda_events = _param.getJpdaEvents();
+                    this->motion_model = _param.getMotionModel();
+                    this->imm_stay = _param.getImmStay();
+                    this->imm_turn_rate = _param.getImmTurnRate();
+                    this->reid_gallery = _param.getReidGallery();
+                    this->reid_ttl = _param.getReidTtl();
+                    this->reid_thresh = _param.getReidThresh();
+                    this->reid_speed = _param.getReidSpeed();
+                    this->ann_links = _param.getAnnLinks();
+                    this->ann_ef_construction = _param.getAnnEfConstruction();
+                    this->ann_ef_search = _param.getAnnEfSearch();
+                    this->ann_neighbors = _param.getAnnNeighbors();
                     return *this;
                 }
                 
@@ -148,6 +653,30 @@ namespace mctracker
                     std::cout << "[ASSOCDUMMYCOST]: " << assoc_dummy_cost << std::endl;
                     std::cout << "[NEW_HYP_DUMMY_COST]: " << new_hyp_dummy_cost << std::endl;
                     std::cout << "[DT]: " << d_t << std::endl;
+                    std::cout << "[FUSIONRADIUS]: " << fusion_radius << std::endl;
+                    std::cout << "[FPS]: " << fps << std::endl;
+                    std::cout << "[HISTORY]: " << history << std::endl;
+                    std::cout << "[TRAJECTORYLOG]: " << trajectory_log << std::endl;
+                    std::cout << "[DETECTIONLOG]: " << detection_log << std::endl;
+                    std::cout << "[DETERMINISTIC]: " << deterministic << std::endl;
+                    std::cout << "[SEED]: " << seed << std::endl;
+                    std::cout << "[ASSOCIATION]: " << association << std::endl;
+                    std::cout << "[MHTHYPOTHESES]: " << mht_hypotheses << std::endl;
+                    std::cout << "[MHTSCAN]: " << mht_scan << std::endl;
+                    std::cout << "[JPDAPD]: " << jpda_pd << std::endl;
+                    std::cout << "[JPDACLUTTER]: " << jpda_clutter << std::endl;
+                    std::cout << "[JPDAEVENTS]: " << jpda_events << std::endl;
+                    std::cout << "[MOTIONMODEL]: " << motion_model << std::endl;
+                    std::cout << "[IMMSTAY]: " << imm_stay << std::endl;
+                    std::cout << "[IMMTURNRATE]: " << imm_turn_rate << std::endl;
+                    std::cout << "[REIDGALLERY]: " << reid_gallery << std::endl;
+                    std::cout << "[REIDTTL]: " << reid_ttl << std::endl;
+                    std::cout << "[REIDTHRESH]: " << reid_thresh << std::endl;
+                    std::cout << "[REIDSPEED]: " << reid_speed << std::endl;
+                    std::cout << "[ANNLINKS]: " << ann_links << std::endl;
+                    std::cout << "[ANNEFCONSTRUCTION]: " << ann_ef_construction << std::endl;
+                    std::cout << "[ANNEFSEARCH]: " << ann_ef_search << std::endl;
+                    std::cout << "[ANNNEIGHBORS]: " << ann_neighbors << std::endl;
                 }
             private:
                 uint max_missed;
@@ -155,6 +684,30 @@ namespace mctracker
                 float d_t;
                 uint assoc_dummy_cost;
                 uint new_hyp_dummy_cost;
+                float fusion_radius;
+                float fps;
+                uint history;
+                std::string trajectory_log;
+                std::string detection_log;
+                bool deterministic;
+                uint seed;
+                std::string association;
+                uint mht_hypotheses;
+                uint mht_scan;
+                float jpda_pd;
+                float jpda_clutter;
+                uint jpda_events;
+                std::string motion_model;
+                float imm_stay;
+                float imm_turn_rate;
+                uint reid_gallery;
+                float reid_ttl;
+                float reid_thresh;
+                float reid_speed;
+                uint ann_links;
+                uint ann_ef_construction;
+                uint ann_ef_search;
+                uint ann_neighbors;
         };
     }
 }
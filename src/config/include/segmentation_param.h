@@ -0,0 +1,91 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _SEGMENTATION_PARAM_H_
+#define _SEGMENTATION_PARAM_H_
+
+#include <iostream>
+
+namespace mctracker
+{
+    namespace config
+    {
+        class SegmentationParam
+        {
+            public:
+                /**
+                 * @brief Constructor class SegmentationParam
+                 */
+                SegmentationParam() : scale(1.), engine("KNN") { ; }
+                
+                /**
+                 * @brief set the scale at which the background model is computed
+                 * @param s value in (0, 1] containing the scale
+                 */
+                void
+                setScale(const float& s)
+                {
+                    scale = s;
+                }
+                
+                /**
+                 * @brief get the scale at which the background model is computed
+                 * @return the scale
+                 */
+                inline const float
+                getScale() const
+                {
+                    return scale;
+                }
+                
+                /**
+                 * @brief set the engine used for computing the background model
+                 * @param e string containing the engine: KNN, MOG2, AVERAGE or MEDIAN
+                 */
+                void
+                setEngine(const std::string& e)
+                {
+                    engine = e;
+                }
+                
+                /**
+                 * @brief get the engine used for computing the background model
+                 * @return a string containing the engine
+                 */
+                inline const std::string
+                getEngine() const
+                {
+                    return engine;
+                }
+                
+                /**
+                 * @brief copy operator
+                 * @param _param object to copy
+                 * @return the pointer to the current instance
+                 */ 
+                SegmentationParam& operator=(const SegmentationParam& _param)
+                {
+                    scale = _param.getScale();
+                    engine = _param.getEngine();
+                    return *this;
+                }
+                
+                /**
+                 * @brief print all the parameters
+                 */
+                void 
+                print()
+                {
+                    std::cout << "[SCALE]: " << scale << std::endl;
+                    std::cout << "[ENGINE]: " << engine << std::endl;
+                }
+                
+            private:
+                float scale;
+                std::string engine;
+        };
+    }
+}
+
+#endif
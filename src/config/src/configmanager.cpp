@@ -72,6 +72,49 @@ ConfigManager::read(const std::string& config)
         }
         ss.str("");
         param.setProximity(prox);
+        
+        ss << "DetectionInterval" << i+1;
+        int interval;
+        if(!yamlManager.getElem(ss.str(), interval) || interval < 1)
+        {
+            interval = 1;
+        }
+        ss.str("");
+        param.setDetectionInterval(interval);
+        
+        ss << "MotionThreshold" << i+1;
+        float motion;
+        if(!yamlManager.getElem(ss.str(), motion))
+        {
+            motion = .05;
+        }
+        ss.str("");
+        param.setMotionThreshold(motion);
+        
+        ss << "Resolution" << i+1;
+        std::vector<int> resolution;
+        if(!yamlManager.getElem(ss.str(), resolution) || resolution.size() != 2)
+        {
+            //native resolution
+            resolution = {0, 0};
+        }
+        ss.str("");
+        param.setResolution(resolution.at(0), resolution.at(1));
+        
+        ss << "Format" << i+1;
+        std::string format;
+        if(!yamlManager.getElem(ss.str(), format))
+        {
+            format = "BGR";
+        }
+        else if(format != "BGR" && format != "GRAY")
+        {
+            std::cout << "Format"<< i+1 << " has to be BGR or GRAY!" << std::endl;
+            return false;
+        }
+        ss.str("");
+        param.setFormat(format);
+        
         cameraParam.push_back(param);
     }
     
@@ -85,6 +128,28 @@ ConfigManager::read(const std::string& config)
         kalmanParam.setDt(1.0);
         kalmanParam.setMaxMissed(15);
         kalmanParam.setMinPropagate(15);
+        kalmanParam.setFusionRadius(30.);
+        kalmanParam.setFps(7.);
+        kalmanParam.setHistory(10);
+        kalmanParam.setDeterministic(false);
+        kalmanParam.setSeed(12345);
+        kalmanParam.setAssociation("GNN");
+        kalmanParam.setMhtHypotheses(4);
+        kalmanParam.setMhtScan(3);
+        kalmanParam.setJpdaPd(0.9);
+        kalmanParam.setJpdaClutter(1e-6);
+        kalmanParam.setJpdaEvents(10000);
+        kalmanParam.setMotionModel("CV");
+        kalmanParam.setImmStay(0.9);
+        kalmanParam.setImmTurnRate(0.);
+        kalmanParam.setReidGallery(0);
+        kalmanParam.setReidTtl(120.);
+        kalmanParam.setReidThresh(0.8);
+        kalmanParam.setReidSpeed(100.);
+        kalmanParam.setAnnLinks(8);
+        kalmanParam.setAnnEfConstruction(64);
+        kalmanParam.setAnnEfSearch(32);
+        kalmanParam.setAnnNeighbors(0);
     }
     else
     {   
@@ -128,6 +193,167 @@ ConfigManager::read(const std::string& config)
             kalmanParam.setMaxMissed(1.0);
         } 
         kalmanParam.setDt( dt );
+        
+        float radius;
+        if(!kalmanReader.getElem("FUSIONRADIUS", radius))
+        {
+            radius = 30.;
+        }
+        kalmanParam.setFusionRadius(radius);
+        
+        float fps;
+        if(!kalmanReader.getElem("FPS", fps) || fps <= 0)
+        {
+            fps = 7.;
+        }
+        kalmanParam.setFps(fps);
+        
+        if(!kalmanReader.getElem("HISTORY", tmpValue) || tmpValue < 1)
+        {
+            tmpValue = 10;
+        }
+        kalmanParam.setHistory(uint(tmpValue));
+        
+        std::string logFile;
+        if(kalmanReader.getElem("TRAJECTORYLOG", logFile))
+        {
+            kalmanParam.setTrajectoryLog(logFile);
+        }
+        
+        if(kalmanReader.getElem("DETECTIONLOG", logFile))
+        {
+            kalmanParam.setDetectionLog(logFile);
+        }
+        
+        bool deterministic;
+        if(!kalmanReader.getElem("DETERMINISTIC", deterministic))
+        {
+            deterministic = false;
+        }
+        kalmanParam.setDeterministic(deterministic);
+        
+        if(!kalmanReader.getElem("SEED", tmpValue) || tmpValue < 0)
+        {
+            tmpValue = 12345;
+        }
+        kalmanParam.setSeed(uint(tmpValue));
+        
+        std::string association;
+        if(!kalmanReader.getElem("ASSOCIATION", association) || (association != "GNN" && association != "MHT" && association != "JPDA"))
+        {
+            association = "GNN";
+        }
+        kalmanParam.setAssociation(association);
+        
+        if(!kalmanReader.getElem("MHTHYPOTHESES", tmpValue) || tmpValue < 1)
+        {
+            tmpValue = 4;
+        }
+        kalmanParam.setMhtHypotheses(uint(tmpValue));
+        
+        if(!kalmanReader.getElem("MHTSCAN", tmpValue) || tmpValue < 0 || tmpValue > 16)
+        {
+            tmpValue = 3;
+        }
+        kalmanParam.setMhtScan(uint(tmpValue));
+        
+        float pd;
+        if(!kalmanReader.getElem("JPDAPD", pd) || pd <= 0 || pd >= 1)
+        {
+            pd = 0.9;
+        }
+        kalmanParam.setJpdaPd(pd);
+        
+        float clutter;
+        if(!kalmanReader.getElem("JPDACLUTTER", clutter) || clutter <= 0)
+        {
+            clutter = 1e-6;
+        }
+        kalmanParam.setJpdaClutter(clutter);
+        
+        if(!kalmanReader.getElem("JPDAEVENTS", tmpValue) || tmpValue < 1)
+        {
+            tmpValue = 10000;
+        }
+        kalmanParam.setJpdaEvents(uint(tmpValue));
+        
+        std::string model;
+        if(!kalmanReader.getElem("MOTIONMODEL", model) || (model != "CV" && model != "IMM"))
+        {
+            model = "CV";
+        }
+        kalmanParam.setMotionModel(model);
+        
+        //the hypotheses keep constant velocity states and their commit would overwrite the models of the tracks
+        if(model == "IMM" && association == "MHT")
+        {
+            throw std::invalid_argument("MOTIONMODEL: IMM cannot be used with ASSOCIATION: MHT in " + kalman_file);
+        }
+        
+        float stay;
+        if(!kalmanReader.getElem("IMMSTAY", stay) || stay <= 0 || stay >= 1)
+        {
+            stay = 0.9;
+        }
+        kalmanParam.setImmStay(stay);
+        
+        float rate;
+        if(!kalmanReader.getElem("IMMTURNRATE", rate) || rate < 0)
+        {
+            rate = 0.;
+        }
+        kalmanParam.setImmTurnRate(rate);
+        
+        if(!kalmanReader.getElem("REIDGALLERY", tmpValue) || tmpValue < 0)
+        {
+            tmpValue = 0;
+        }
+        kalmanParam.setReidGallery(uint(tmpValue));
+        
+        float ttl;
+        if(!kalmanReader.getElem("REIDTTL", ttl) || ttl <= 0)
+        {
+            ttl = 120.;
+        }
+        kalmanParam.setReidTtl(ttl);
+        
+        float thresh;
+        if(!kalmanReader.getElem("REIDTHRESH", thresh) || thresh <= 0 || thresh > 1)
+        {
+            thresh = 0.8;
+        }
+        kalmanParam.setReidThresh(thresh);
+        
+        float speed;
+        if(!kalmanReader.getElem("REIDSPEED", speed) || speed <= 0)
+        {
+            speed = 100.;
+        }
+        kalmanParam.setReidSpeed(speed);
+        
+        if(!kalmanReader.getElem("ANNLINKS", tmpValue) || tmpValue < 2)
+        {
+            tmpValue = 8;
+        }
+        kalmanParam.setAnnLinks(uint(tmpValue));
+        
+        if(!kalmanReader.getElem("ANNEFCONSTRUCTION", tmpValue) || tmpValue < 1)
+        {
+            tmpValue = 64;
+        }
+        kalmanParam.setAnnEfConstruction(uint(tmpValue));
+        
+        if(!kalmanReader.getElem("ANNEFSEARCH", tmpValue) || tmpValue < 1)
+        {
+            tmpValue = 32;
+        }
+        kalmanParam.setAnnEfSearch(uint(tmpValue));
+        
+        if(!kalmanReader.getElem("ANNNEIGHBORS", tmpValue) || tmpValue < 0)
+        {
+            tmpValue = 0;
+        }
+        kalmanParam.setAnnNeighbors(uint(tmpValue));
     }
     
     std::string detectorTmpVal;
@@ -166,6 +392,65 @@ ConfigManager::read(const std::string& config)
     }
     
     detectorParam.setThreshold(thresh);
+    
+    bool roi;
+    if(!yamlManager.getElem("ROIDetection", roi))
+    {
+        roi = false;
+    }
+    detectorParam.setRoi(roi);
+    
+    int roiValue;
+    if(!yamlManager.getElem("ROIMaxTiles", roiValue))
+    {
+        roiValue = 4;
+    }
+    detectorParam.setRoiMaxTiles(roiValue);
+    
+    if(!yamlManager.getElem("ROIMinArea", roiValue))
+    {
+        roiValue = 400;
+    }
+    detectorParam.setRoiMinArea(roiValue);
+    
+    if(!yamlManager.getElem("ROIPadding", roiValue))
+    {
+        roiValue = 32;
+    }
+    detectorParam.setRoiPadding(roiValue);
+    
+    int asyncValue;
+    if(!yamlManager.getElem("Contexts", asyncValue) || asyncValue < 1)
+    {
+        asyncValue = 1;
+    }
+    detectorParam.setContexts(asyncValue);
+    
+    if(!yamlManager.getElem("MaxInFlight", asyncValue) || asyncValue < 1)
+    {
+        asyncValue = 2;
+    }
+    detectorParam.setMaxInFlight(asyncValue);
+    
+    if(!yamlManager.getElem("MaxStaleFrames", asyncValue) || asyncValue < 0)
+    {
+        asyncValue = 0;
+    }
+    detectorParam.setMaxStaleFrames(asyncValue);
+    
+    float scale;
+    if(!yamlManager.getElem("BgScale", scale) || scale <= 0 || scale > 1)
+    {
+        scale = 1.;
+    }
+    segmentationParam.setScale(scale);
+    
+    std::string engine;
+    if(!yamlManager.getElem("BgEngine", engine))
+    {
+        engine = "KNN";
+    }
+    segmentationParam.setEngine(engine);
 
     return true;    
 }
@@ -189,6 +474,10 @@ ConfigManager::print()
     std::cout << std::endl;
     std::cout << "DETECTOR" << std::endl;
     detectorParam.print();
+    
+    std::cout << std::endl;
+    std::cout << "SEGMENTATION" << std::endl;
+    segmentationParam.print();
 }
 
 bool 
@@ -294,9 +294,6 @@ YamlManager::getElem(const std::string& name, std::vector<int>& elem)
                 return false;
             }
         }
-    }
-    else
-    {
         return true;
     }
     return false;
@@ -320,9 +317,6 @@ YamlManager::getElem(const std::string& name, std::vector<float>& elem)
                 return false;
             }
         }
-    }
-    else
-    {
         return true;
     }
     return false;
@@ -347,9 +341,6 @@ YamlManager::getElem(const std::string& name, std::vector<double>& elem)
                 return false;
             }
         }
-    }
-    else
-    {
         return true;
     }
     return false;
@@ -403,10 +394,6 @@ YamlManager::getElem(const std::string& name, cv::Mat& elem, int type)
         }
         return true;
     }
-    else
-    {
-        return true;
-    }
     return false;
 }
 
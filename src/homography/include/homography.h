@@ -59,6 +59,21 @@ namespace mctracker
                  * @param y variable where the y-coordinate of the converted point will be stored
                  */
                 static void calcProjection(const cv::Point2f &point, const cv::Mat &H, double &x, double &y);
+                /**
+                 * @brief calculate the projection of point give the homography matrix
+                 * @param point point to be converted
+                 * @param H homography matrix stored row by row in 9 doubles
+                 * @param x variable where the x-coordinate of the converted point will be stored
+                 * @param y variable where the y-coordinate of the converted point will be stored
+                 */
+                static void calcProjection(const cv::Point2f &point, const double *H, double &x, double &y);
+                /**
+                 * @brief calculate the projection of a set of points give the homography matrix
+                 * @param points points to be converted
+                 * @param H homography matrix stored row by row in 9 doubles
+                 * @param projected vector where the converted points will be stored
+                 */
+                static void calcProjection(const std::vector<cv::Point2f> &points, const double *H, std::vector<cv::Point2f> &projected);
             private:
                 std::vector<cv::Point2f> srcPoints; 
                 std::vector<cv::Point2f> dstPoints; 
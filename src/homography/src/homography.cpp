@@ -1,5 +1,9 @@
 #include "homography.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace mctracker;
 using namespace mctracker::geometry;
 
@@ -162,10 +166,58 @@ Homography::calcProjection(const cv::Point2f &point, const cv::Mat &H, double &x
         throw std::invalid_argument("Invaling homography");
     }
     
-	x =	(point.x*H.at<double>(0,0)+point.y*H.at<double>(0,1)+H.at<double>(0,2))/
-			(point.x*H.at<double>(2,0)+point.y*H.at<double>(2,1)+H.at<double>(2,2));
-	y =	(point.x*H.at<double>(1,0)+point.y*H.at<double>(1,1)+H.at<double>(1,2))/
-			(point.x*H.at<double>(2,0)+point.y*H.at<double>(2,1)+H.at<double>(2,2));
+    const cv::Mat& Hd = H.isContinuous() ? H : H.clone();
+    calcProjection(point, Hd.ptr<double>(), x, y);
+}
+
+void 
+Homography::calcProjection(const cv::Point2f &point, const double *H, double &x, double &y) 
+{
+    const double& w = point.x*H[6] + point.y*H[7] + H[8];
+    x = (point.x*H[0] + point.y*H[1] + H[2]) / w;
+    y = (point.x*H[3] + point.y*H[4] + H[5]) / w;
+}
+
+void 
+Homography::calcProjection(const std::vector<cv::Point2f> &points, const double *H, std::vector<cv::Point2f> &projected) 
+{
+    const size_t& n = points.size();
+    projected.resize(n);
+    
+    const float* src = reinterpret_cast<const float*>(points.data());
+    float* dst = reinterpret_cast<float*>(projected.data());
+    size_t i = 0;
+    
+#if defined(__SSE2__)
+    const __m128d h0 = _mm_set1_pd(H[0]), h1 = _mm_set1_pd(H[1]), h2 = _mm_set1_pd(H[2]);
+    const __m128d h3 = _mm_set1_pd(H[3]), h4 = _mm_set1_pd(H[4]), h5 = _mm_set1_pd(H[5]);
+    const __m128d h6 = _mm_set1_pd(H[6]), h7 = _mm_set1_pd(H[7]), h8 = _mm_set1_pd(H[8]);
+    
+    //two points for each iteration: x0 y0 x1 y1
+    for(; i + 2 <= n; i += 2)
+    {
+        const __m128 p = _mm_loadu_ps(src + 2*i);
+        const __m128d p0 = _mm_cvtps_pd(p);
+        const __m128d p1 = _mm_cvtps_pd(_mm_movehl_ps(p, p));
+        const __m128d px = _mm_unpacklo_pd(p0, p1);
+        const __m128d py = _mm_unpackhi_pd(p0, p1);
+        
+        const __m128d w = _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, h6), _mm_mul_pd(py, h7)), h8);
+        const __m128d x = _mm_div_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, h0), _mm_mul_pd(py, h1)), h2), w);
+        const __m128d y = _mm_div_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(px, h3), _mm_mul_pd(py, h4)), h5), w);
+        
+        const __m128 q0 = _mm_cvtpd_ps(_mm_unpacklo_pd(x, y));
+        const __m128 q1 = _mm_cvtpd_ps(_mm_unpackhi_pd(x, y));
+        _mm_storeu_ps(dst + 2*i, _mm_movelh_ps(q0, q1));
+    }
+#endif
+    
+    for(; i < n; ++i)
+    {
+        double x, y;
+        calcProjection(points[i], H, x, y);
+        projected[i] = cv::Point2f(x, y);
+    }
 }
 
 void
@@ -0,0 +1,73 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _DETECTION_SCHEDULER_H_
+#define _DETECTION_SCHEDULER_H_
+
+#include <iostream>
+#include <opencv2/opencv.hpp>
+#include "yolo_v2_class.hpp"
+
+namespace mctracker
+{
+    namespace objectdetection
+    {
+        class DetectionScheduler
+        {
+            public:
+                /**
+                 * @brief Constructor class DetectionScheduler
+                 */
+                DetectionScheduler() { ; }
+                /**
+                 * @brief Constructor class DetectionScheduler
+                 * @param _interval number of frames between two runs of the detector
+                 * @param _motionThreshold change of the foreground ratio which forces a run of the detector
+                 * @param _minBlobArea minimum area of a foreground blob used between two runs of the detector
+                 */
+                DetectionScheduler(const int& _interval, const float& _motionThreshold, const int& _minBlobArea);
+                /**
+                 * @brief decide if the detector has to run on the current frame
+                 * @param fgMask the foreground mask of the current frame
+                 * @return true if the detector has to run, false otherwise
+                 */
+                bool schedule(const cv::Mat& fgMask);
+                /**
+                 * @brief report if the detector has accepted the frame scheduled, a rejected frame is scheduled again
+                 * on the next one and it is not counted as a run
+                 * @param accepted true if the frame has been submitted to the detector
+                 */
+                void report(const bool& accepted);
+                /**
+                 * @brief extract the foreground blobs used as detections when the detector does not run
+                 * @param fgMask the foreground mask of the current frame
+                 * @param sz the size of the frame
+                 * @return a vector of bbox_t containing the bounding boxes of the blobs in frame coordinates
+                 */
+                std::vector<bbox_t> blobs(const cv::Mat& fgMask, const cv::Size& sz) const;
+            public:
+                /**
+                 * @brief get the ratio of frames on which the detector has been run
+                 * @return the duty cycle of the detector
+                 */
+                inline const float 
+                dutyCycle() const
+                {
+                    return frames == 0 ? 0. : float(runs) / frames;
+                }
+            private:
+                int interval;
+                float motionThreshold;
+                int minBlobArea;
+                int frames;
+                int runs;
+                int sinceLast;
+                float lastEnergy;
+                //motion energy of the last frame scheduled
+                float energy;
+        };
+    }
+}
+
+#endif
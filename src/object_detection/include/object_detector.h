@@ -7,18 +7,39 @@
 
 #include <iostream>
 #include <future>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <deque>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
 #include <opencv2/opencv.hpp>
 #include "detector_param.h"
+#include "threadpool.h"
 #include "yolo_v2_class.hpp"
 
 
 using namespace mctracker::config;
+using namespace mctracker::utils;
 namespace mctracker
 {
     namespace objectdetection
     {
         class ObjectDetector
         {
+            public:
+                //detections of a submitted frame, with the frame they were computed on
+                struct Result
+                {
+                    uint64_t frame;
+                    double timestamp;
+                    cv::Mat image;
+                    cv::Mat fgMask;
+                    std::vector<bbox_t> dets;
+                };
             public:
                 /**
                  * @brief Constructor class Homography
@@ -32,6 +53,49 @@ namespace mctracker
                  * @return a cv::Mat containing the original frame with the detections drawed on (if draw is true)
                  */
                 cv::Mat classify(cv::Mat& frame, bool draw = true);
+                /**
+                 * @brief classify the foreground regions of the current frame
+                 * @param frame cv::Mat containing the image to classify
+                 * @param fgMask cv::Mat containing the foreground mask of the frame
+                 * @param draw boolean which if is true allow the function to draw the detections
+                 * @return a cv::Mat containing the original frame with the detections drawed on (if draw is true)
+                 */
+                cv::Mat classify(cv::Mat& frame, const cv::Mat& fgMask, bool draw = true);
+                /**
+                 * @brief detect the people in a frame, it can be called concurrently from different threads
+                 * @param frame cv::Mat containing the image to classify
+                 * @param fgMask cv::Mat containing the foreground mask of the frame (if any)
+                 * @return a vector of bbox_t containing all the detections
+                 */
+                std::vector<bbox_t> detect(const cv::Mat& frame, const cv::Mat& fgMask = cv::Mat());
+                /**
+                 * @brief submit a frame to the detector without waiting for the result
+                 * @param camera the index of the camera which acquired the frame
+                 * @param frameId the index of the frame in the sequence
+                 * @param timestamp the acquisition time of the frame
+                 * @param frame cv::Mat containing the image to classify
+                 * @param fgMask cv::Mat containing the foreground mask of the frame (if any)
+                 * @return false if the camera has already reached the maximum number of requests in flight
+                 */
+                bool submit(const uint& camera, const uint64_t& frameId, const double& timestamp, const cv::Mat& frame, 
+                            const cv::Mat& fgMask = cv::Mat());
+                /**
+                 * @brief get the detections of a submitted frame: the requests older than the stale limit are discarded, 
+                 * a ready result not older than the limit is preferred, otherwise the result of the frame is awaited
+                 * @param camera the index of the camera which acquired the frame
+                 * @param frameId the index of the frame in the sequence
+                 * @param result where the detections are stored with the index, the timestamp, the image and the mask 
+                 * of the frame they belong to, which is older than frameId when a stale result is returned
+                 * @return false if there is no request in flight for the frame
+                 */
+                bool poll(const uint& camera, const uint64_t& frameId, Result& result);
+                /**
+                 * @brief drop the requests of a camera up to a frame which will not be polled, 
+                 * the ones which are not running yet do not reach the network
+                 * @param camera the index of the camera which acquired the frames
+                 * @param frameId the index of the last frame to drop
+                 */
+                void cancel(const uint& camera, const uint64_t& frameId);
             public:
                 /**
                  * @brief return the detections of the last classified frame
@@ -52,14 +116,64 @@ namespace mctracker
                 /**
                  * @brief refine all the detections according to the thresholds specified in the config file
                  * @param dets the vector of bbox_t containing all the detections
+                 * @return a vector of bbox_t containing the refined detections
                  */
-                void refining(const std::vector<bbox_t>& dets);
+                std::vector<bbox_t> refining(const std::vector<bbox_t>& dets) const;
+                /**
+                 * @brief run the network on an image
+                 * @param img the image to classify
+                 * @return a vector of bbox_t containing all the raw detections
+                 */
+                std::vector<bbox_t> run(const cv::Mat& img);
+                /**
+                 * @brief extract the tiles containing the foreground regions
+                 * @param fgMask the foreground mask
+                 * @param sz the size of the frame
+                 * @return a vector containing the tiles on which the detector has to run
+                 */
+                std::vector<cv::Rect> foreground_tiles(const cv::Mat& fgMask, const cv::Size& sz) const;
+                /**
+                 * @brief place the tiles in a mosaic with the aspect ratio of the frame, as small as possible
+                 * @param tiles the tiles
+                 * @param sz the size of the frame
+                 * @param canvas where the size of the mosaic is stored
+                 * @param places where the position of each tile in the mosaic is stored
+                 * @return false if the tiles do not fit in a mosaic of the size of the frame
+                 */
+                bool pack(const std::vector<cv::Rect>& tiles, const cv::Size& sz, cv::Size& canvas, std::vector<cv::Rect>& places) const;
+            private:
+                //asynchronous request of a camera
+                struct Request
+                {
+                    uint64_t frame;
+                    double timestamp;
+                    cv::Mat image;
+                    cv::Mat fgMask;
+                    std::future< std::vector<bbox_t> > result;
+                    std::shared_ptr< std::atomic<bool> > cancelled;
+                };
             private:
                 std::string cfg, weights;
                 float minimum_thresh;
-                std::shared_ptr<Detector> detector;
-                std::vector<bbox_t> dets;
+                bool roi;
+                int roiMaxTiles, roiMinArea, roiPadding;
+                int maxInFlight, maxStaleFrames;
+                std::vector< std::shared_ptr<Detector> > contexts;
+                std::vector<int> freeContexts;
+                std::mutex mtx;
+                std::condition_variable condition;
+                std::map< uint, std::deque<Request> > requests;
+                std::mutex requestMtx;
                 std::vector<bbox_t> final_dets;
+                //declared last: the pending requests are completed before the contexts are released
+                std::shared_ptr<ThreadPool> pool;
+            private:
+                //above this ratio of the frame the full frame is classified
+                static constexpr float max_roi_ratio = .5;
+                //empty pixels between two tiles of the mosaic
+                static constexpr int tile_gap = 8;
+                //sizes of the mosaic tried, relative to the frame
+                static constexpr float mosaic_scales[] = {.5, .75, 1.};
         };
     }
 }
@@ -0,0 +1,72 @@
+#include "detection_scheduler.h"
+
+using namespace mctracker;
+using namespace mctracker::objectdetection;
+
+DetectionScheduler
+::DetectionScheduler(const int& _interval, const float& _motionThreshold, const int& _minBlobArea)
+    : interval(std::max(_interval, 1)), motionThreshold(_motionThreshold), minBlobArea(_minBlobArea)
+{
+    frames = 0;
+    runs = 0;
+    sinceLast = 0;
+    lastEnergy = 0.;
+    energy = 0.;
+}
+
+bool 
+DetectionScheduler::schedule(const cv::Mat& fgMask)
+{
+    //motion energy: ratio of foreground pixels
+    energy = fgMask.empty() ? 0. : float(cv::countNonZero(fgMask)) / fgMask.total();
+    frames++;
+    
+    //the detector runs at least once
+    return (runs == 0) || (++sinceLast >= interval) || (std::abs(energy - lastEnergy) > motionThreshold);
+}
+
+void 
+DetectionScheduler::report(const bool& accepted)
+{
+    if(accepted)
+    {
+        sinceLast = 0;
+        lastEnergy = energy;
+        runs++;
+    }
+}
+
+std::vector<bbox_t> 
+DetectionScheduler::blobs(const cv::Mat& fgMask, const cv::Size& sz) const
+{
+    std::vector<bbox_t> boxes;
+    if(fgMask.empty())
+    {
+        return boxes;
+    }
+    
+    //the mask can be computed at a lower scale than the frame
+    const float& sx = float(sz.width) / fgMask.cols;
+    const float& sy = float(sz.height) / fgMask.rows;
+    
+    cv::Mat labels, stats, centroids;
+    const int& nLabels = cv::connectedComponentsWithStats(fgMask, labels, stats, centroids, 8, CV_32S);
+    
+    //label 0 is the background
+    for(auto i = 1; i < nLabels; ++i)
+    {
+        if(stats.at<int>(i, cv::CC_STAT_AREA) * sx * sy < minBlobArea)
+        {
+            continue;
+        }
+        
+        bbox_t box = bbox_t();
+        box.x = stats.at<int>(i, cv::CC_STAT_LEFT) * sx;
+        box.y = stats.at<int>(i, cv::CC_STAT_TOP) * sy;
+        box.w = stats.at<int>(i, cv::CC_STAT_WIDTH) * sx;
+        box.h = stats.at<int>(i, cv::CC_STAT_HEIGHT) * sy;
+        boxes.push_back(box);
+    }
+    
+    return boxes;
+}
@@ -3,22 +3,48 @@
 using namespace mctracker;
 using namespace mctracker::objectdetection;
 
+constexpr float ObjectDetector::mosaic_scales[];
+
 ObjectDetector
 ::ObjectDetector(const DetectorParam& params) 
 {
     cfg = params.getConfig();
     weights = params.getWeights();
     minimum_thresh = params.getThreshold();
-    detector = std::shared_ptr<Detector>(new Detector(cfg, weights));
+    roi = params.getRoi();
+    roiMaxTiles = std::max(params.getRoiMaxTiles(), 1);
+    roiMinArea = params.getRoiMinArea();
+    roiPadding = params.getRoiPadding();
+    maxInFlight = std::max(params.getMaxInFlight(), 1);
+    maxStaleFrames = std::max(params.getMaxStaleFrames(), 0);
+    
+    //each context is a copy of the network which can run concurrently with the others
+    const int& nContexts = std::max(params.getContexts(), 1);
+    for(auto i = 0; i < nContexts; ++i)
+    {
+        contexts.push_back(std::shared_ptr<Detector>(new Detector(cfg, weights)));
+        freeContexts.push_back(i);
+    }
+    pool = std::shared_ptr<ThreadPool>(new ThreadPool(nContexts));
 }
 
 
 cv::Mat 
 ObjectDetector::classify(cv::Mat& frame, bool draw)
 {
-    final_dets.clear();
-    dets = detector->detect(frame);
-    refining(dets);
+    final_dets = detect(frame);
+    if(draw)
+    {
+        draw_boxes(frame, final_dets);
+    }
+    return frame;
+}
+
+
+cv::Mat 
+ObjectDetector::classify(cv::Mat& frame, const cv::Mat& fgMask, bool draw)
+{
+    final_dets = detect(frame, fgMask);
     if(draw)
     {
         draw_boxes(frame, final_dets);
@@ -27,17 +53,336 @@ ObjectDetector::classify(cv::Mat& frame, bool draw)
 }
 
 
+std::vector<bbox_t> 
+ObjectDetector::detect(const cv::Mat& frame, const cv::Mat& fgMask)
+{
+    if(!roi || fgMask.empty())
+    {
+        return refining(run(frame));
+    }
+    
+    const auto& tiles = foreground_tiles(fgMask, frame.size());
+    
+    auto area = 0;
+    for(const auto& tile : tiles)
+    {
+        area += tile.area();
+    }
+    
+    //when the foreground covers most of the frame the mosaic would not be smaller than the frame
+    if(area > max_roi_ratio * frame.size().area())
+    {
+        return refining(run(frame));
+    }
+    
+    if(tiles.empty())
+    {
+        return std::vector<bbox_t>();
+    }
+    
+    //the network resizes any input to its own size: each tile alone would cost a full pass, 
+    //so the tiles are packed in a single mosaic with the aspect ratio of the frame
+    std::vector<cv::Rect> places;
+    cv::Size canvas;
+    if(!pack(tiles, frame.size(), canvas, places))
+    {
+        return refining(run(frame));
+    }
+    
+    cv::Mat mosaic(canvas, frame.type(), cv::Scalar::all(0));
+    for(auto i = 0; i < int(tiles.size()); ++i)
+    {
+        frame(tiles.at(i)).copyTo(mosaic(places.at(i)));
+    }
+    
+    std::vector<bbox_t> dets;
+    for(auto det : run(mosaic))
+    {
+        //a box belongs to the tile of its center, it is clipped to it and moved back to frame coordinates
+        const cv::Point center(det.x + det.w / 2, det.y + det.h / 2);
+        for(auto i = 0; i < int(places.size()); ++i)
+        {
+            const auto& place = places.at(i);
+            if(place.contains(center))
+            {
+                const cv::Rect& box = cv::Rect(det.x, det.y, det.w, det.h) & place;
+                det.x = box.x - place.x + tiles.at(i).x;
+                det.y = box.y - place.y + tiles.at(i).y;
+                det.w = box.width;
+                det.h = box.height;
+                dets.push_back(det);
+                break;
+            }
+        }
+    }
+    
+    return refining(dets);
+}
+
+
+bool 
+ObjectDetector::pack(const std::vector<cv::Rect>& tiles, const cv::Size& sz, cv::Size& canvas, std::vector<cv::Rect>& places) const
+{
+    //shelves filled from left to right, the tallest tiles first
+    std::vector<int> order(tiles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&tiles](const int& a, const int& b) { return tiles.at(a).height > tiles.at(b).height; });
+    
+    //the smallest canvas holding all the tiles gives them the highest resolution in the network
+    for(const auto& scale : mosaic_scales)
+    {
+        canvas = cv::Size(sz.width * scale, sz.height * scale);
+        places.assign(tiles.size(), cv::Rect());
+        auto x = 0, y = 0, shelf = 0;
+        auto fits = true;
+        for(const auto& i : order)
+        {
+            const auto& tile = tiles.at(i);
+            if(x + tile.width > canvas.width)
+            {
+                x = 0;
+                y += shelf + tile_gap;
+                shelf = 0;
+            }
+            
+            if(tile.width > canvas.width || y + tile.height > canvas.height)
+            {
+                fits = false;
+                break;
+            }
+            
+            places.at(i) = cv::Rect(x, y, tile.width, tile.height);
+            x += tile.width + tile_gap;
+            shelf = std::max(shelf, tile.height);
+        }
+        
+        if(fits)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+
+bool 
+ObjectDetector::submit(const uint& camera, const uint64_t& frameId, const double& timestamp, const cv::Mat& frame, 
+                       const cv::Mat& fgMask)
+{
+    std::lock_guard<std::mutex> lock(requestMtx);
+    auto& queue = requests[camera];
+    if(int(queue.size()) >= maxInFlight)
+    {
+        return false;
+    }
+    
+    //the caller is free to reuse its buffers as soon as the request is submitted
+    const cv::Mat& img = frame.clone();
+    const cv::Mat& mask = fgMask.clone();
+    Request request;
+    request.frame = frameId;
+    request.timestamp = timestamp;
+    request.image = img;
+    request.fgMask = mask;
+    request.cancelled = std::make_shared< std::atomic<bool> >(false);
+    const auto& cancelled = request.cancelled;
+    request.result = pool->enqueue([this, img, mask, cancelled]()
+    {
+        //a request dropped before it starts does not take a context
+        return (*cancelled) ? std::vector<bbox_t>() : detect(img, mask);
+    });
+    queue.push_back(std::move(request));
+    return true;
+}
+
+
+bool 
+ObjectDetector::poll(const uint& camera, const uint64_t& frameId, Result& result)
+{
+    std::future< std::vector<bbox_t> > future;
+    {
+        std::lock_guard<std::mutex> lock(requestMtx);
+        auto& queue = requests[camera];
+        
+        //the results which are too old are not useful anymore
+        while(!queue.empty() && queue.front().frame + maxStaleFrames < frameId)
+        {
+            *queue.front().cancelled = true;
+            queue.pop_front();
+        }
+        
+        //the requests are sorted by frame: take the newest one not after the current frame
+        auto chosen = -1;
+        for(auto i = 0; i < int(queue.size()) && queue.at(i).frame <= frameId; ++i)
+        {
+            chosen = i;
+        }
+        
+        if(chosen == -1)
+        {
+            return false;
+        }
+        
+        //a stale result already available is preferred to waiting for the current one
+        if(maxStaleFrames > 0 && queue.at(chosen).result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            for(auto i = chosen - 1; i >= 0; --i)
+            {
+                if(queue.at(i).result.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    chosen = i;
+                    break;
+                }
+            }
+        }
+        
+        //the stale result is given back with its own frame, so that it is placed at its acquisition time
+        auto& request = queue.at(chosen);
+        future = std::move(request.result);
+        result.frame = request.frame;
+        result.timestamp = request.timestamp;
+        result.image = request.image;
+        result.fgMask = request.fgMask;
+        for(auto i = 0; i < chosen; ++i)
+        {
+            *queue.at(i).cancelled = true;
+        }
+        queue.erase(queue.begin(), queue.begin() + chosen + 1);
+    }
+    
+    //wait outside the lock: the other cameras can submit and poll in the meantime
+    result.dets = future.get();
+    return true;
+}
+
+
 void 
-ObjectDetector::refining(const std::vector<bbox_t>& dets)
+ObjectDetector::cancel(const uint& camera, const uint64_t& frameId)
+{
+    std::lock_guard<std::mutex> lock(requestMtx);
+    auto& queue = requests[camera];
+    while(!queue.empty() && queue.front().frame <= frameId)
+    {
+        *queue.front().cancelled = true;
+        queue.pop_front();
+    }
+}
+
+
+std::vector<bbox_t> 
+ObjectDetector::run(const cv::Mat& img)
+{
+    //each context can be used by one camera at a time
+    int context;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        condition.wait(lock, [this]() { return !freeContexts.empty(); });
+        context = freeContexts.back();
+        freeContexts.pop_back();
+    }
+    
+    const auto& dets = contexts.at(context)->detect(img);
+    
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        freeContexts.push_back(context);
+    }
+    condition.notify_one();
+    
+    return dets;
+}
+
+
+std::vector<cv::Rect> 
+ObjectDetector::foreground_tiles(const cv::Mat& fgMask, const cv::Size& sz) const
+{
+    std::vector<cv::Rect> tiles;
+    const cv::Rect frameRect(cv::Point(0, 0), sz);
+    
+    //the mask can be computed at a lower scale than the frame
+    const float& sx = float(sz.width) / fgMask.cols;
+    const float& sy = float(sz.height) / fgMask.rows;
+    
+    cv::Mat labels, stats, centroids;
+    const int& nLabels = cv::connectedComponentsWithStats(fgMask, labels, stats, centroids, 8, CV_32S);
+    
+    //label 0 is the background
+    for(auto i = 1; i < nLabels; ++i)
+    {
+        if(stats.at<int>(i, cv::CC_STAT_AREA) * sx * sy < roiMinArea)
+        {
+            continue;
+        }
+        
+        cv::Rect r(stats.at<int>(i, cv::CC_STAT_LEFT) * sx - roiPadding, stats.at<int>(i, cv::CC_STAT_TOP) * sy - roiPadding, 
+                   stats.at<int>(i, cv::CC_STAT_WIDTH) * sx + 2 * roiPadding, stats.at<int>(i, cv::CC_STAT_HEIGHT) * sy + 2 * roiPadding);
+        tiles.push_back(r & frameRect);
+    }
+    
+    auto merge_overlapping = [](std::vector<cv::Rect>& rects)
+    {
+        bool merged = true;
+        while(merged)
+        {
+            merged = false;
+            for(int i = 0; i < int(rects.size()) && !merged; ++i)
+            {
+                for(int j = i + 1; j < int(rects.size()); ++j)
+                {
+                    if((rects.at(i) & rects.at(j)).area() > 0)
+                    {
+                        rects.at(i) |= rects.at(j);
+                        rects.erase(rects.begin() + j);
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    };
+    
+    merge_overlapping(tiles);
+    
+    //merge the closest tiles until the maximum number is reached
+    while(int(tiles.size()) > roiMaxTiles)
+    {
+        auto best_i = 0, best_j = 1;
+        auto min_increase = std::numeric_limits<int>::max();
+        for(int i = 0; i < int(tiles.size()); ++i)
+        {
+            for(int j = i + 1; j < int(tiles.size()); ++j)
+            {
+                const auto& increase = (tiles.at(i) | tiles.at(j)).area() - tiles.at(i).area() - tiles.at(j).area();
+                if(increase < min_increase)
+                {
+                    min_increase = increase;
+                    best_i = i;
+                    best_j = j;
+                }
+            }
+        }
+        tiles.at(best_i) |= tiles.at(best_j);
+        tiles.erase(tiles.begin() + best_j);
+        merge_overlapping(tiles);
+    }
+    
+    return tiles;
+}
+
+std::vector<bbox_t> 
+ObjectDetector::refining(const std::vector<bbox_t>& dets) const
 {
+    std::vector<bbox_t> refined;
     for(const auto& det : dets)
     {
         //0 corresponds to PERSON and minimum_thresh is the minimum threshold I consider for being a person
         if(det.obj_id == 0 && det.prob >= minimum_thresh) 
         {
-            final_dets.push_back(det);
+            refined.push_back(det);
         }
     }
+    return refined;
 }
 
 
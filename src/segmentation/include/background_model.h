@@ -0,0 +1,133 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _BACKGROUND_MODEL_H_
+#define _BACKGROUND_MODEL_H_
+
+#include <iostream>
+#include <memory>
+#include <opencv2/opencv.hpp>
+
+namespace mctracker
+{
+    namespace segmentation
+    {
+        class BackgroundModel
+        {
+            public:
+                /**
+                 * @brief Constructor class BackgroundModel
+                 */
+                BackgroundModel() { ; }
+                virtual ~BackgroundModel() { ; }
+                /**
+                 * @brief create a background model given its name
+                 * @param engine the name of the engine: KNN, MOG2, AVERAGE or MEDIAN
+                 * @return a pointer to the background model
+                 */
+                static std::shared_ptr<BackgroundModel> create(const std::string& engine);
+                /**
+                 * @brief update the background model and compute the foreground mask
+                 * @param frame the current frame
+                 * @param fgMask the foreground mask, where 255 represents the foreground
+                 * @param learningRate the learning rate of the model, a negative value means automatic
+                 */
+                virtual void apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate) = 0;
+                /**
+                 * @brief get the learning rate of the model at a given frame
+                 * @param frameNum the number of frames already processed
+                 * @return the learning rate to pass to apply, a negative value means automatic
+                 */
+                virtual double learningRate(const int& frameNum) const;
+                /**
+                 * @brief get the name of the engine
+                 * @return a string containing the name of the engine
+                 */
+                virtual const std::string name() const = 0;
+        };
+        
+        class KnnModel : public BackgroundModel
+        {
+            public:
+                /**
+                 * @brief Constructor class KnnModel
+                 */
+                KnnModel();
+                void apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate);
+                inline const std::string 
+                name() const
+                {
+                    return "KNN";
+                }
+            private:
+                cv::Ptr<cv::BackgroundSubtractorKNN> model;
+        };
+        
+        class Mog2Model : public BackgroundModel
+        {
+            public:
+                /**
+                 * @brief Constructor class Mog2Model
+                 */
+                Mog2Model();
+                void apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate);
+                inline const std::string 
+                name() const
+                {
+                    return "MOG2";
+                }
+            private:
+                cv::Ptr<cv::BackgroundSubtractorMOG2> model;
+        };
+        
+        class RunningAverageModel : public BackgroundModel
+        {
+            public:
+                /**
+                 * @brief Constructor class RunningAverageModel
+                 */
+                RunningAverageModel() : frames(0) { ; }
+                void apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate);
+                inline const std::string 
+                name() const
+                {
+                    return "AVERAGE";
+                }
+            private:
+                cv::UMat gray;
+                cv::UMat background;
+                cv::UMat background8U;
+                cv::UMat diff;
+                int frames;
+            private:
+                static constexpr double min_alpha = 0.005;
+                static constexpr double diff_thresh = 25;
+        };
+        
+        class MedianModel : public BackgroundModel
+        {
+            public:
+                /**
+                 * @brief Constructor class MedianModel
+                 */
+                MedianModel() { ; }
+                void apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate);
+                inline const std::string 
+                name() const
+                {
+                    return "MEDIAN";
+                }
+            private:
+                cv::UMat gray;
+                cv::UMat background;
+                cv::UMat diff;
+                cv::UMat greater;
+                cv::UMat lower;
+            private:
+                static constexpr double diff_thresh = 25;
+        };
+    }
+}
+
+#endif
@@ -3,6 +3,10 @@
 
 #include <iostream>
 #include <opencv2/opencv.hpp>
+#include "segmentation_param.h"
+#include "background_model.h"
+
+using namespace mctracker::config;
 
 namespace mctracker
 {
@@ -16,6 +20,11 @@ namespace mctracker
                 */
                 BgSubtraction();
                 /**
+                * @brief Constructor class BgSubtraction
+                * @param param the segmentation parameters
+                */
+                BgSubtraction(const SegmentationParam& param);
+                /**
                 * @brief compute the background model
                 * @param frame cv::Mat containing the current frame
                 * @param morph a boolean which if is true enable morphology operations on the resulting foreground mask
@@ -23,7 +32,7 @@ namespace mctracker
                 void process(const cv::Mat& frame, bool morph = true);
             public:
                 /**
-                 * @brief get the foreground mask
+                 * @brief get the foreground mask at the processing scale
                  * @param mask cv::Mat variable in which the mask will be stored
                  * @return true if the mask is ready, false otherwise
                  */
@@ -37,12 +46,54 @@ namespace mctracker
                     }
                     return false;
                 }
+                
+                /**
+                 * @brief get the name of the engine computing the background model
+                 * @return a string containing the name of the engine
+                 */
+                inline const std::string 
+                engine() const
+                {
+                    return model->name();
+                }
+                
+                /**
+                 * @brief get the cost of the background model on the last frame
+                 * @return the cost in milliseconds
+                 */
+                inline const double 
+                getCost() const
+                {
+                    return cost;
+                }
+                
+                /**
+                 * @brief get the average cost of the background model
+                 * @return the average cost per frame in milliseconds
+                 */
+                inline const double 
+                getMeanCost() const
+                {
+                    return frameNum == 0 ? 0. : totalCost / frameNum;
+                }
             private:
-                cv::Ptr<cv::BackgroundSubtractorKNN> pMOG2;
-                double learningRate;
+                /**
+                 * @brief initialize the background model
+                 * @param engine the name of the engine
+                 */
+                void init(const std::string& engine);
+            private:
+                std::shared_ptr<BackgroundModel> model;
+                double cost, totalCost;
                 int frameNum;
                 cv::UMat fgMask;
                 cv::UMat ref_frame;
+                cv::UMat small_frame;
+                float scale;
+                cv::Size blurSize;
+            private:
+                //blur kernel size at full resolution
+                static constexpr int blur_size = 15;
         };
     }
 }
@@ -0,0 +1,129 @@
+#include "background_model.h"
+
+using namespace mctracker;
+using namespace mctracker::segmentation;
+
+std::shared_ptr<BackgroundModel> 
+BackgroundModel::create(const std::string& engine)
+{
+    if(engine == "KNN")
+    {
+        return std::shared_ptr<BackgroundModel>(new KnnModel);
+    }
+    else if(engine == "MOG2")
+    {
+        return std::shared_ptr<BackgroundModel>(new Mog2Model);
+    }
+    else if(engine == "AVERAGE")
+    {
+        return std::shared_ptr<BackgroundModel>(new RunningAverageModel);
+    }
+    else if(engine == "MEDIAN")
+    {
+        return std::shared_ptr<BackgroundModel>(new MedianModel);
+    }
+    
+    throw std::invalid_argument("Invalid background engine: " + engine);
+}
+
+double 
+BackgroundModel::learningRate(const int& frameNum) const
+{
+    //decrease the learning rate when the background model becomes more reliable
+    if(frameNum < 100) 
+    {
+        return -1;
+    } 
+    else if(frameNum < 1000) 
+    {
+        return -.1;
+    } 
+    
+    return -0.001;
+}
+
+KnnModel
+::KnnModel()
+{
+    model = cv::createBackgroundSubtractorKNN();
+}
+
+void 
+KnnModel::apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate)
+{
+    model->apply(frame, fgMask, learningRate);
+}
+
+Mog2Model
+::Mog2Model()
+{
+    model = cv::createBackgroundSubtractorMOG2();
+}
+
+void 
+Mog2Model::apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate)
+{
+    model->apply(frame, fgMask, learningRate);
+}
+
+void 
+RunningAverageModel::apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate)
+{
+    if(frame.channels() == 3)
+    {
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    }
+    else
+    {
+        frame.copyTo(gray);
+    }
+    
+    if(background.empty())
+    {
+        gray.convertTo(background, CV_32F);
+        fgMask = cv::UMat::zeros(gray.size(), CV_8UC1);
+        frames++;
+        return;
+    }
+    
+    background.convertTo(background8U, CV_8U);
+    cv::absdiff(gray, background8U, diff);
+    cv::threshold(diff, fgMask, diff_thresh, 255, cv::THRESH_BINARY);
+    
+    //automatic learning rate: cumulative average first, then a slow exponential one
+    const double& alpha = (learningRate >= 0) ? learningRate : std::max(1. / (frames + 1), double(min_alpha));
+    cv::accumulateWeighted(gray, background, alpha);
+    frames++;
+}
+
+void 
+MedianModel::apply(const cv::UMat& frame, cv::UMat& fgMask, const double& learningRate)
+{
+    if(frame.channels() == 3)
+    {
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    }
+    else
+    {
+        frame.copyTo(gray);
+    }
+    
+    if(background.empty())
+    {
+        gray.copyTo(background);
+        fgMask = cv::UMat::zeros(gray.size(), CV_8UC1);
+        return;
+    }
+    
+    cv::absdiff(gray, background, diff);
+    cv::threshold(diff, fgMask, diff_thresh, 255, cv::THRESH_BINARY);
+    
+    //approximated median: the background moves by one level towards the current frame
+    if(learningRate != 0)
+    {
+        cv::compare(gray, background, greater, cv::CMP_GT);
+        cv::compare(gray, background, lower, cv::CMP_LT);
+        cv::add(background, cv::Scalar::all(1), background, greater);
+        cv::subtract(background, cv::Scalar::all(1), background, lower);
+    }
+}
@@ -5,32 +5,51 @@ using namespace mctracker::segmentation;
 
 BgSubtraction
 ::BgSubtraction()
+    : scale(1.)
 {
-    pMOG2 = cv::createBackgroundSubtractorKNN();
+    init("KNN");
+}
+
+BgSubtraction
+::BgSubtraction(const SegmentationParam& param)
+    : scale(param.getScale())
+{
+    init(param.getEngine());
+}
+
+void
+BgSubtraction::init(const std::string& engine)
+{
+    model = BackgroundModel::create(engine);
     frameNum = 0;
+    cost = 0.;
+    totalCost = 0.;
+    
+    //the blur kernel shrinks with the image, keeping an odd size
+    const int& k = std::max(3, int(blur_size * scale) | 1);
+    blurSize = cv::Size(k, k);
 }
 
 void
 BgSubtraction::process(const cv::Mat& frame, bool morph)
 {
-    //Decrease the learning rate when the background model becomes more reliable
-    if (frameNum < 100) 
-    {
-        learningRate = -1;
-    } 
-    else if (frameNum < 1000) 
+    cv::UMat frameUMat = frame.getUMat(cv::ACCESS_READ);
+    
+    //the whole pipeline runs at the processing scale
+    if(scale < 1.)
     {
-        learningRate = -.1;
-    } 
-    else 
+        cv::resize(frameUMat, small_frame, cv::Size(), scale, scale, cv::INTER_AREA);
+        cv::blur(small_frame, ref_frame, blurSize);
+    }
+    else
     {
-        learningRate = -0.001;
+        cv::blur(frameUMat, ref_frame, blurSize);
     }
-
-    cv::UMat frameUMat = frame.getUMat(cv::ACCESS_WRITE);
-    cv::blur(frameUMat, ref_frame, cv::Size(15, 15));   
     
-    pMOG2->apply(ref_frame, fgMask, learningRate);
+    const double& start = cv::getTickCount();
+    model->apply(ref_frame, fgMask, model->learningRate(frameNum));
+    cost = (cv::getTickCount() - start) * 1000. / cv::getTickFrequency();
+    totalCost += cost;
     cv::compare(fgMask, cv::Scalar(255), fgMask, cv::CMP_EQ);
     
     if(morph)
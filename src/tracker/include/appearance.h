@@ -0,0 +1,52 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _APPEARANCE_H_
+#define _APPEARANCE_H_
+
+#include <iostream>
+#include <array>
+#include <opencv2/opencv.hpp>
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class Appearance
+        {
+            public:
+                //the hsv histogram is pooled on a coarse grid: hue cells x saturation cells
+                static constexpr int hue_cells = 10;
+                static constexpr int sat_cells = 12;
+                static constexpr uint size = hue_cells * sat_cells;
+                typedef std::array<float, size> Descriptor;
+            public:
+                /**
+                 * @brief compute the compact descriptor of a hsv histogram: pooled, zero mean and unit norm,
+                 * so that the dot product of two descriptors is the correlation of the pooled histograms
+                 * @param hist the hsv histogram
+                 * @param d where the descriptor is stored
+                 */
+                static void describe(const cv::Mat& hist, Descriptor& d);
+                /**
+                 * @brief compute the similarity between two descriptors
+                 * @param a the first descriptor
+                 * @param b the second descriptor
+                 * @return the correlation in [-1, 1]
+                 */
+                static inline const float
+                similarity(const Descriptor& a, const Descriptor& b)
+                {
+                    float dot = 0;
+                    for(uint i = 0; i < size; ++i)
+                    {
+                        dot += a[i] * b[i];
+                    }
+                    return dot;
+                }
+        };
+    }
+}
+
+#endif
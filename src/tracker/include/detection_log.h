@@ -0,0 +1,74 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _DETECTION_LOG_H_
+#define _DETECTION_LOG_H_
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+#include "detection.h"
+#include "utils.h"
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class DetectionLog
+        {
+            public:
+                /**
+                 * @brief Constructor class DetectionLog
+                 */
+                DetectionLog() { ; }
+                /**
+                 * @brief open the binary file where the input of the tracker is recorded
+                 * @param file the path to the file
+                 */
+                void create(const std::string& file);
+                /**
+                 * @brief open a recorded binary file for replaying it
+                 * @param file the path to the file
+                 */
+                void open(const std::string& file);
+                /**
+                 * @brief record the input of a tracking step
+                 * @param _detections the detections coming from all the cameras
+                 * @param timestamps the acquisition times, a single value if the cameras share the same time
+                 * @param w width of the tracking space
+                 * @param h height of the tracking space
+                 */
+                void write(const std::vector<Detections>& _detections, const std::vector<double>& timestamps, const int& w, const int& h);
+                /**
+                 * @brief read the input of the next tracking step
+                 * @param _detections vector where the detections coming from all the cameras are stored
+                 * @param timestamps vector where the acquisition times are stored
+                 * @param w width of the tracking space
+                 * @param h height of the tracking space
+                 * @return true if a step has been read, false at the end of the file
+                 */
+                bool read(std::vector<Detections>& _detections, std::vector<double>& timestamps, int& w, int& h);
+            public:
+                /**
+                 * @brief check if the recording is enabled
+                 * @return true if a file is open for writing
+                 */
+                inline const bool
+                isRecording() const
+                {
+                    return out.is_open();
+                }
+            private:
+                std::ofstream out;
+                std::ifstream in;
+            private:
+                static constexpr uint32_t magic = 0x5344434d; //MCDS
+        };
+    }
+}
+
+#endif
@@ -14,6 +14,7 @@
 #include "drawing.h"
 #include "utils.h"
 #include "camera.h"
+#include "ring_buffer.h"
 
 using namespace mctracker::utils;
 
@@ -24,6 +25,9 @@ namespace mctracker
         class Entity
         {   
             friend class Tracker;
+            friend class MultiHypothesis;
+            friend class Jpda;
+            friend class ImmBank;
 
             public:
                 /**
@@ -63,25 +67,7 @@ namespace mctracker
                         auto i = 0;
                         for(auto& img : images)
                         {
-                            auto p = getPoint();
-                            auto imPoint = cameras.at(i).world2camera(p);
-                            const std::vector<cv::Size>& sz = sizes;
-                            const cv::Size& curr_size = sz.at(i);
-                            if(curr_size.width != 0)
-                            {
-                                imPoint.y -= curr_size.height;
-                                imPoint.x -= (curr_size.width>>1);
-
-                                if(imPoint.x >= 0 && imPoint.y >= 0 && (imPoint.x + curr_size.width) < (img.cols - 1) && (imPoint.y + curr_size.height) < (img.rows - 1))
-                                {
-                                    tools::Drawing::rectangle(cv::Rect(imPoint.x, imPoint.y, curr_size.width, curr_size.height), color, img);
-                                    std::stringstream ss;
-                                    ss << "#" << label2string();
-    
-                                    cv::putText(img, ss.str().c_str(), imPoint, cv::FONT_HERSHEY_SIMPLEX,
-                                                            0.55, cv::Scalar(0, 255, 0), 2, CV_AA);
-                                }
-                            }
+                            draw_view(cameras.at(i).world2camera(getPoint()), i, img);
                             ++i;
                         }
                     }
@@ -103,7 +89,7 @@ namespace mctracker
                                             0.55, cv::Scalar(0, 255, 0), 2, CV_AA);
                         
                         if(history) 
-                            tools::Drawing::history(m_history, color, img);
+                            tools::Drawing::history(m_history.toVector(), color, img);
                     }
                 }
                 
@@ -114,13 +100,25 @@ namespace mctracker
                 inline const Points 
                 history() const
                 {
-                    return m_history;
+                    return m_history.toVector();
                 }
                 
             protected:
                 typedef std::shared_ptr<KalmanFilter> Kalman_ptr;
             protected:
                 virtual const std::string label2string() = 0;
+            private:
+                /**
+                 * @brief draw the entity in a single camera view
+                 * @param imPoint the position of the entity in image coordinates
+                 * @param view the index of the camera view
+                 * @param img the current frame of the camera
+                 */
+                inline const void 
+                draw_view(const cv::Point2f& imPoint, const int& view, cv::Mat& img)
+                {
+                    tools::Drawing::box(imPoint, sizes.at(view), color, label2string(), img);
+                }
             protected:
                 /**
                  * @brief set the color of the entity
@@ -173,26 +171,27 @@ namespace mctracker
                 }
                 
                 /**
-                 * @brief check the history of the entity in order to keep only the last 10 observations
+                 * @brief get the inverse of the error measurement covariance matrix of the kalman filter associated to the entity
+                 * @return the inverse of the error measurement covariance matrix
                  */
-                const 
-                void checkHistory()
+                inline const cv::Matx22f
+                invS() const
                 {
-                    if(m_history.size() > history_size)
-                    {
-                        m_history.erase(m_history.begin());
-                    }
+                    return kf->invS();
                 }
                 
+            public:
+                //maximum number of positions in the history
+                constexpr static uint max_history = 64;
             protected:
-                Points m_history;
+                typedef RingBuffer<cv::Point, max_history> History;
+            protected:
+                History m_history;
                 cv::Scalar color;
                 Kalman_ptr kf;
                 uint w, h;
                 bool isgood;
                 std::vector<cv::Size> sizes;
-            protected:
-                constexpr static uint history_size = 10;
         };
     }
 }
@@ -0,0 +1,68 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _FOV_MAP_H_
+#define _FOV_MAP_H_
+
+#include <iostream>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "camera.h"
+
+using namespace mctracker::utils;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class FovMap
+        {
+            public:
+                /**
+                 * @brief Constructor class FovMap
+                 */
+                FovMap() : rows(0), cols(0) { ; }
+                /**
+                 * @brief Constructor class FovMap
+                 * @param cameras the camera stack whose fields of view have to be merged
+                 */
+                FovMap(const std::vector<Camera>& cameras);
+            public:
+                /**
+                 * @brief get the cameras which see a point of the plan view, a camera sees the cells where its
+                 * fov image is 255: a mask different from 0 is the isVisible test of at least one camera
+                 * @param p the point in plan view coordinates
+                 * @return a mask where the bit i is set if the camera i sees the point
+                 */
+                inline const ushort 
+                cameras(const cv::Point2f& p) const
+                {
+                    if(p.x < 0 || p.y < 0 || p.x >= cols || p.y >= rows)
+                    {
+                        return 0;
+                    }
+                    return coverage[int(p.y) * cols + int(p.x)];
+                }
+                
+                /**
+                 * @brief check if a point of the plan view is seen by a camera
+                 * @param p the point in plan view coordinates
+                 * @param camera the index of the camera
+                 * @return true if the camera sees the point, false otherwise
+                 */
+                inline const bool 
+                isVisible(const cv::Point2f& p, const int& camera) const
+                {
+                    return (cameras(p) >> camera) & 1;
+                }
+            private:
+                //one mask of cameras for each cell of the plan view
+                std::vector<ushort> coverage;
+                int rows, cols;
+        };
+    }
+}
+
+#endif
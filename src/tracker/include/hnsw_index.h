@@ -0,0 +1,198 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _HNSW_INDEX_H_
+#define _HNSW_INDEX_H_
+
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <opencv2/opencv.hpp>
+
+#include "appearance.h"
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class HnswIndex
+        {
+            public:
+                typedef Appearance::Descriptor Descriptor;
+                //distance and id of a result
+                typedef std::pair<float, int> Neighbor;
+            public:
+                /**
+                 * @brief Constructor class HnswIndex: hierarchical navigable small world graph over appearance descriptors,
+                 * the distance is 1 - correlation
+                 * @param _m the number of links of a node in the upper layers, twice in the bottom one: more links give
+                 * a higher recall and a slower insertion
+                 * @param _efConstruction the size of the candidate list used for linking a new node
+                 * @param _efSearch the size of the candidate list of a query: the recall/latency trade-off of the lookups
+                 */
+                HnswIndex(const uint& _m, const uint& _efConstruction, const uint& _efSearch);
+                /**
+                 * @brief add a descriptor to the index, an id already in the index is replaced
+                 * @param id the id of the descriptor
+                 * @param d the descriptor
+                 */
+                void insert(const int& id, const Descriptor& d);
+                /**
+                 * @brief remove a descriptor from the index, the nodes which pointed to it are linked to its neighbours
+                 * @param id the id of the descriptor
+                 */
+                void erase(const int& id);
+                /**
+                 * @brief find the approximate nearest neighbours of a descriptor
+                 * @param q the query descriptor
+                 * @param k the number of neighbours
+                 * @param results vector where the neighbours are stored, sorted by distance
+                 */
+                void search(const Descriptor& q, const uint& k, std::vector<Neighbor>& results);
+            public:
+                /**
+                 * @brief get the number of descriptors in the index
+                 * @return the number of descriptors
+                 */
+                inline const uint
+                size() const
+                {
+                    return count;
+                }
+
+                /**
+                 * @brief check if an id is in the index
+                 * @param id the id
+                 * @return true if the id is in the index
+                 */
+                inline const bool
+                contains(const int& id) const
+                {
+                    return slots.find(id) != slots.end();
+                }
+
+                /**
+                 * @brief get the descriptor of an id in the index
+                 * @param id the id
+                 * @return the descriptor
+                 */
+                inline const Descriptor&
+                descriptor(const int& id) const
+                {
+                    return nodes.at(slots.at(id)).d;
+                }
+
+                /**
+                 * @brief set the size of the candidate list of the queries
+                 * @param ef the size of the list
+                 */
+                inline void
+                setEf(const uint& ef)
+                {
+                    efSearch = ef;
+                }
+            private:
+                //a node of the graph, its links in each layer and the nodes linking to it
+                struct Node
+                {
+                    int id;
+                    int level;
+                    bool used;
+                    Descriptor d;
+                    std::vector< std::vector<int> > links;
+                    std::vector< std::vector<int> > inbound;
+                };
+            private:
+                /**
+                 * @brief compute the distance between two descriptors
+                 * @param a the first descriptor
+                 * @param b the second descriptor
+                 * @return 1 - correlation
+                 */
+                inline const float
+                distance(const Descriptor& a, const Descriptor& b) const
+                {
+                    return 1.f - Appearance::similarity(a, b);
+                }
+
+                /**
+                 * @brief get the maximum number of links of a node in a layer
+                 * @param level the layer
+                 * @return the number of links
+                 */
+                inline const uint
+                maxLinks(const int& level) const
+                {
+                    return (level == 0) ? 2 * m : m;
+                }
+
+                /**
+                 * @brief move greedily towards the query in a layer
+                 * @param q the query
+                 * @param ep the starting node
+                 * @param level the layer
+                 * @return the closest node found
+                 */
+                int greedy(const Descriptor& q, int ep, const int& level) const;
+                /**
+                 * @brief beam search of a layer
+                 * @param q the query
+                 * @param ep the starting node
+                 * @param ef the size of the beam
+                 * @param level the layer
+                 * @param found vector where the closest nodes are stored (distance, slot), sorted by distance
+                 */
+                void search_layer(const Descriptor& q, const int& ep, const uint& ef, const int& level, std::vector<Neighbor>& found);
+                /**
+                 * @brief keep the candidates which are closer to the node than to the neighbours already selected,
+                 * the others fill the free links
+                 * @param list the candidates (distance, slot) sorted by distance, the selected ones are left
+                 * @param n the maximum number of neighbours
+                 */
+                void select_neighbors(std::vector<Neighbor>& list, const uint& n);
+                /**
+                 * @brief prune the links of a node in a layer down to the maximum
+                 * @param slot the node
+                 * @param level the layer
+                 */
+                void shrink(const int& slot, const int& level);
+                /**
+                 * @brief add a directed link
+                 * @param from the source node
+                 * @param to the destination node
+                 * @param level the layer
+                 */
+                void connect(const int& from, const int& to, const int& level);
+                /**
+                 * @brief remove a directed link
+                 * @param from the source node
+                 * @param to the destination node
+                 * @param level the layer
+                 */
+                void disconnect(const int& from, const int& to, const int& level);
+            private:
+                uint m;
+                uint efConstruction;
+                uint efSearch;
+                double ml;
+                cv::RNG rng;
+                std::vector<Node> nodes;
+                std::vector<int> freeSlots;
+                //slot of each id
+                std::unordered_map<int, int> slots;
+                int entry;
+                int maxLevel;
+                uint count;
+                //buffers of the searches
+                std::vector<uint> visited;
+                uint visit;
+                std::vector<Neighbor> candidates, found, selected, kept, pruned, neighbors;
+                std::vector<int> repair, linking, dropped;
+            private:
+                static constexpr int max_level = 16;
+        };
+    }
+}
+
+#endif
@@ -75,6 +75,10 @@ namespace mctracker
                     // Computes a suboptimal solution. Good for cases with many forbidden assignments.
                     // --------------------------------------------------------------------------
                     void assignmentsuboptimal2(assignments_t& assignment, track_t& cost, const distMatrix_t& distMatrixIn, const size_t& nOfRows, const size_t& nOfColumns);
+                private:
+                    //buffers of the optimal method, a solver kept alive does not allocate them at each call
+                    distMatrix_t distMatrix;
+                    BoolVec coveredColumns, coveredRows, starMatrix, primeMatrix, newStarMatrix;
             };
         }
     }
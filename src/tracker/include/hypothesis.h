@@ -15,6 +15,7 @@
 #include "detection.h"
 #include "kalman_param.h"
 #include "track.h"
+#include "track_pool.h"
 #include "utils.h"
 
 using namespace mctracker::tracker::costs;
@@ -32,7 +33,7 @@ namespace mctracker
                 static std::shared_ptr<Hyphothesis> instance();
                 /**
                  * @brief compare the previous unassigned points to the new detection in order to create new tracks
-                 * @param dummmy_assignments a matrix containing the assignment coming from the hungarian algorithm
+                 * @param assignments the detection assigned to each track by the hungarian algorithm, -1 if none
                  * @param tracks the se of the current tracks
                  * @param w width of the tracking space
                  * @param h height of the tracking space
@@ -41,10 +42,15 @@ namespace mctracker
                  * @param param kalman parameters
                  * @param cameraNum camera number
                  */
-                void new_hyphothesis(const cv::Mat& dummmy_assignments, Tracks& tracks, const Detections& detections, const uint& w, const uint& h,
+                void new_hyphothesis(const assignments_t& assignments, Tracks& tracks, const Detections& detections, const uint& w, const uint& h,
                                                         const uint& new_hyp_dummy_costs, Detections& prev_unassigned, const KalmanParam& param, const int cameraNum);
             private:
                 static std::shared_ptr<Hyphothesis> m_instance;
+                //buffers reused among the frames
+                std::vector<char> assigned;
+                std::vector<int> unassigned;
+                std::vector< std::vector<int> > lap_costs;
+                std::vector<int> rowsol, colsol, u, v;
             private:
                 // 15 sig. digits for 0<=real(z)<=171
                 // coeffs should sum to about g*g/2+23/24	
@@ -0,0 +1,114 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _IMM_BANK_H_
+#define _IMM_BANK_H_
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <opencv2/opencv.hpp>
+
+#include "track.h"
+#include "hungarianAlg.h"
+#include "utils.h"
+
+using namespace mctracker::tracker::costs;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class ImmBank
+        {
+            private:
+                typedef std::shared_ptr<Track> Track_ptr;
+                typedef std::vector<Track_ptr> Tracks;
+            public:
+                //constant position, constant velocity and two coordinated turns (left and right)
+                static constexpr uint max_models = 4;
+            public:
+                /**
+                 * @brief Constructor class ImmBank
+                 * @param _stay the probability that a track keeps its motion model between two frames
+                 * @param _turnRate the turn rate of the coordinated-turn models in radians per frame, 0 disables them
+                 * @param _frameDt the dt of the kalman filters corresponding to one frame
+                 */
+                ImmBank(const float& _stay, const float& _turnRate, const float& _frameDt);
+                /**
+                 * @brief mix the models of each track, predict them and write the combined prediction into the tracks,
+                 * the model matrices are computed once for all the tracks
+                 * @param tracks the current tracks, their dt has to be already set
+                 */
+                void predict(const Tracks& tracks);
+                /**
+                 * @brief correct the models of the assigned tracks, update the model probabilities with their likelihoods
+                 * and write the combined estimate into the tracks
+                 * @param tracks the current tracks
+                 * @param assignment the detection assigned to each track, -1 if none
+                 * @param detections the fused detections of the current frame
+                 */
+                void correct(const Tracks& tracks, const assignments_t& assignment, const Detections& detections);
+            public:
+                /**
+                 * @brief get the number of motion models of each track
+                 * @return the number of models
+                 */
+                inline const uint
+                size() const
+                {
+                    return nModels;
+                }
+            private:
+                //the models of a track: fixed-size matrices, no heap allocation
+                struct State
+                {
+                    cv::Matx41f x[max_models];
+                    cv::Matx44f P[max_models];
+                    float mu[max_models];
+                    //the combined state last written into the kalman filter of the track
+                    cv::Matx41f combined;
+                };
+            private:
+                /**
+                 * @brief align the states to the current tracks: the removed tracks are dropped and the new ones
+                 * start all the models from their kalman filter
+                 * @param tracks the current tracks
+                 */
+                void sync(const Tracks& tracks);
+                /**
+                 * @brief recompute the transition matrices and the process noise of the models
+                 * @param dt the time elapsed from the last prediction
+                 * @param F the transition matrix of the constant velocity model
+                 * @param Q the process noise of the constant velocity model
+                 */
+                void update_models(const float& dt, const cv::Matx44f& F, const cv::Matx44f& Q);
+                /**
+                 * @brief combine the models of a track weighted by their probabilities
+                 * @param s the models of the track
+                 * @param x where the combined state is stored
+                 * @param P where the combined covariance is stored
+                 */
+                void combine(const State& s, cv::Matx41f& x, cv::Matx44f& P) const;
+            private:
+                uint nModels;
+                float stay;
+                float turnRate;
+                float frameDt;
+                float d_t;
+                //matrices of the models, shared by all the tracks
+                cv::Matx44f F[max_models];
+                cv::Matx44f Q[max_models];
+                //probability of switching from the model i to the model j
+                float transition[max_models][max_models];
+                std::vector<State> states, next;
+                //serials of the tracks in the order of the states, a recycled track is a new one
+                std::vector<uint64_t> order;
+                std::unordered_map<uint64_t, int> index;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _JPDA_H_
+#define _JPDA_H_
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <numeric>
+#include <opencv2/opencv.hpp>
+
+#include "track.h"
+#include "hungarianAlg.h"
+#include "utils.h"
+
+using namespace mctracker::tracker::costs;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class Jpda
+        {
+            private:
+                typedef std::shared_ptr<Track> Track_ptr;
+                typedef std::vector<Track_ptr> Tracks;
+            public:
+                /**
+                 * @brief Constructor class Jpda
+                 * @param _pd the probability that a target is detected
+                 * @param _clutter the density of the false detections on the plan view
+                 * @param _maxEvents the maximum number of joint events enumerated for a cluster, the bigger clusters are approximated
+                 * @param _gate the maximum Mahalanobis distance between a track and a detection which can originate from it
+                 */
+                Jpda(const float& _pd, const float& _clutter, const uint& _maxEvents, const float& _gate);
+                /**
+                 * @brief compute the association probabilities of the gated pairs cluster by cluster, the tracks which share
+                 * no detection are independent
+                 * @param tracks the current tracks, already predicted
+                 * @param detections the fused detections of the current frame
+                 * @param assignment vector where the most probable detection of each track is stored (one to one), -1 if none,
+                 * it drives the life cycle of the tracks
+                 */
+                void associate(const Tracks& tracks, const Detections& detections, assignments_t& assignment);
+                /**
+                 * @brief replace the state of the tracks which took part in the association with the probabilistic update:
+                 * the innovations of all the gated detections weighted by their probabilities
+                 * @param tracks the current tracks
+                 */
+                void commit(const Tracks& tracks);
+            private:
+                //a gated track-detection pair
+                struct Pair
+                {
+                    int track;
+                    int detection;
+                    //likelihood ratio of the detection originating from the track against being a false detection
+                    double ratio;
+                    double beta;
+                    cv::Vec2f v;
+                };
+            private:
+                /**
+                 * @brief find the root of a track in the union-find of the clusters
+                 * @param i the index of the track
+                 * @return the index of the root track
+                 */
+                int find(int i);
+                /**
+                 * @brief compute the exact association probabilities of a cluster enumerating its joint events
+                 * @param begin the first track of the cluster in members
+                 * @param end the track after the last one of the cluster in members
+                 */
+                void exact(const uint& begin, const uint& end);
+                /**
+                 * @brief recursive step of the enumeration: choose the detection of the track at the given depth
+                 * @param begin the first track of the cluster in members
+                 * @param depth the current track in members
+                 * @param end the track after the last one of the cluster in members
+                 * @param weight the weight of the partial event
+                 */
+                void enumerate(const uint& begin, const uint& depth, const uint& end, const double& weight);
+                /**
+                 * @brief approximate the association probabilities of a cluster (cheap JPDA), linear in the number of pairs
+                 * @param begin the first track of the cluster in members
+                 * @param end the track after the last one of the cluster in members
+                 */
+                void approximate(const uint& begin, const uint& end);
+            private:
+                float pd;
+                float clutter;
+                uint maxEvents;
+                float gate;
+                //the gated pairs grouped by track: the pairs of the track i are in [first[i], first[i + 1])
+                std::vector<Pair> pairs;
+                std::vector<uint> first;
+                //probability that each track is not detected
+                std::vector<double> missed;
+                //clusters: union-find over the tracks, the members are the tracks sorted by cluster
+                std::vector<int> parent;
+                std::vector<int> owner;
+                std::vector<int> members;
+                std::vector<int> roots;
+                //state of the enumeration
+                std::vector<int> chosen;
+                std::vector<char> used;
+                double total;
+                //sums of the approximation
+                std::vector<double> detectionSums;
+                //predicted state of each track and the tracks in the order of the association
+                std::vector<cv::Matx41f> x;
+                std::vector<cv::Matx44f> P;
+                std::vector<const Track*> order;
+                std::vector<int> ranking;
+        };
+    }
+}
+
+#endif
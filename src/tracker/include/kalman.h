@@ -25,6 +25,13 @@ namespace mctracker
                 * @param _dt inital update frequency
                 */
                 KalmanFilter(const float &_x, const float &_y,  const float &dt);
+                /**
+                * @brief reinitialize the filter in place reusing its matrices
+                * @param _x x-coordinate of the current detection
+                * @param _y y-coordinate of the current detection
+                * @param _dt inital update frequency
+                */
+                void init(const float &_x, const float &_y,  const float &dt);
                 
                 /**
                  * @brief get the kalman filter
@@ -47,6 +54,22 @@ namespace mctracker
                  * @return  cv::Mat containing the corrected prediction
                  */
                 cv::Mat correct(const int &_x, const int &_y);
+                /**
+                 * @brief out-of-sequence correction: the measurement is retrodicted to its acquisition time
+                 * and the current state is updated through the cross covariance (Bar-Shalom one-lag approximation)
+                 * @param _x x-coordinate of the late detection
+                 * @param _y y-coordinate of the late detection
+                 * @param lag time elapsed between the acquisition of the detection and the current state
+                 * @return cv::Mat containing the corrected state
+                 */
+                cv::Mat correctLate(const float &_x, const float &_y, const float &lag);
+                /**
+                 * @brief retrodict the measured position to the acquisition time of a late detection
+                 * @param lag time elapsed between the acquisition of the detection and the current state
+                 * @param z where the retrodicted position is stored
+                 * @param iS where the inverse of the retrodicted measurement covariance is stored
+                 */
+                void retrodict(const float &lag, cv::Point2f& z, cv::Matx22f& iS) const;
                 /**
                  * @brief the last prediction
                  * @return a cv;:Mat containing the last prediction
@@ -57,6 +80,16 @@ namespace mctracker
                     return prediction;
                 }
                 
+                /**
+                 * @brief the current corrected state
+                 * @return a cv::Mat containing the state [x, y, vx, vy]
+                 */
+                inline const cv::Mat 
+                getState() const
+                {
+                    return KF.statePost;
+                }
+                
                 /**
                  * @brief get the the control-input model of the kalman filter associated to the entity
                  * @return the control-input model
@@ -88,16 +121,112 @@ namespace mctracker
                 }
                 
                 /**
-                 * @brief set the update frequencies of the entity
+                 * @brief get the inverse of the error measurement covariance matrix without allocating memory
+                 * @return the inverse of the error measurement covariance matrix
+                 */
+                inline const cv::Matx22f
+                invS() const
+                {
+                    const cv::Matx22f s(KF.errorCovPre.at<float>(0, 0) + KF.measurementNoiseCov.at<float>(0, 0),
+                                        KF.errorCovPre.at<float>(0, 1) + KF.measurementNoiseCov.at<float>(0, 1),
+                                        KF.errorCovPre.at<float>(1, 0) + KF.measurementNoiseCov.at<float>(1, 0),
+                                        KF.errorCovPre.at<float>(1, 1) + KF.measurementNoiseCov.at<float>(1, 1));
+                    return s.inv();
+                }
+                
+                /**
+                 * @brief get the transition matrix as a fixed-size matrix
+                 * @return the transition matrix
+                 */
+                inline const cv::Matx44f
+                F() const
+                {
+                    return cv::Matx44f(KF.transitionMatrix.ptr<float>());
+                }
+                
+                /**
+                 * @brief get the process noise covariance as a fixed-size matrix
+                 * @return the process noise covariance
+                 */
+                inline const cv::Matx44f
+                Q() const
+                {
+                    return cv::Matx44f(KF.processNoiseCov.ptr<float>());
+                }
+                
+                /**
+                 * @brief get the measurement noise covariance as a fixed-size matrix
+                 * @return the measurement noise covariance
+                 */
+                inline const cv::Matx22f
+                R() const
+                {
+                    return cv::Matx22f(KF.measurementNoiseCov.ptr<float>());
+                }
+                
+                /**
+                 * @brief get the corrected state and its covariance as fixed-size matrices
+                 * @param x where the state [x, y, vx, vy] is stored
+                 * @param P where the covariance is stored
+                 */
+                inline const void
+                getPosterior(cv::Matx41f& x, cv::Matx44f& P) const
+                {
+                    x = cv::Matx41f(KF.statePost.ptr<float>());
+                    P = cv::Matx44f(KF.errorCovPost.ptr<float>());
+                }
+                
+                /**
+                 * @brief overwrite the corrected state and its covariance, the next prediction starts from them
+                 * @param x the state [x, y, vx, vy]
+                 * @param P the covariance
+                 */
+                inline const void
+                setPosterior(const cv::Matx41f& x, const cv::Matx44f& P)
+                {
+                    std::copy(x.val, x.val + 4, KF.statePost.ptr<float>());
+                    std::copy(P.val, P.val + 16, KF.errorCovPost.ptr<float>());
+                }
+                
+                /**
+                 * @brief replace the prediction step with a state predicted outside the filter (interacting multiple models),
+                 * the next correction starts from it
+                 * @param x the predicted state [x, y, vx, vy]
+                 * @param P the predicted covariance
+                 */
+                inline const void
+                setPrediction(const cv::Matx41f& x, const cv::Matx44f& P)
+                {
+                    std::copy(x.val, x.val + 4, KF.statePre.ptr<float>());
+                    std::copy(P.val, P.val + 16, KF.errorCovPre.ptr<float>());
+                    KF.statePre.copyTo(KF.statePost);
+                    KF.errorCovPre.copyTo(KF.errorCovPost);
+                    std::copy(x.val, x.val + 4, prediction.ptr<float>());
+                }
+                
+                /**
+                 * @brief set the update frequencies of the entity, the transition matrix and the process noise are recomputed
                  * @param dt a float containing the value of dt
                  */
-                const void 
-                setDt(const float& dt)
+                const void setDt(const float& dt);
+                
+                /**
+                 * @brief get the current update frequency
+                 * @return the value of dt
+                 */
+                inline const float
+                getDt() const
                 {
-                    KF.transitionMatrix.at<float>(2) = dt;
-                    KF.transitionMatrix.at<float>(7) = dt;
+                    return d_t;
                 }
 
+            private:
+                /**
+                 * @brief compute the process noise covariance of the constant velocity model (discrete white noise acceleration)
+                 * @param dt a float containing the value of dt
+                 * @param Q cv::Mat where the covariance is stored
+                 */
+                void process_noise(const float& dt, cv::Mat& Q) const;
             private:
                 //the kalman filter
                 cv::KalmanFilter KF;
@@ -106,6 +235,10 @@ namespace mctracker
                 cv::Mat_<float> state;
                 cv::Mat prediction;
                 uint w, h;
+                float d_t;
+            private:
+                //scale of the process noise
+                static constexpr float noise_scale = .3;
         };
     }
 }
@@ -0,0 +1,115 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _MOT_METRICS_H_
+#define _MOT_METRICS_H_
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <opencv2/opencv.hpp>
+
+#include "hungarianAlg.h"
+#include "trajectory_log.h"
+
+using namespace mctracker::tracker::costs;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class MotMetrics
+        {
+            public:
+                /**
+                 * @brief Constructor class MotMetrics
+                 * @param _threshold maximum distance on the plan view between a ground truth object and a matched track
+                 */
+                MotMetrics(const float& _threshold);
+                /**
+                 * @brief accumulate the CLEAR MOT statistics of a frame
+                 * @param gt the ground truth objects of the frame
+                 * @param hyp the tracks of the frame
+                 */
+                void update(const std::vector<TrajectoryRecord>& gt, const std::vector<TrajectoryRecord>& hyp);
+                /**
+                 * @brief compute the identity metrics, it has to be called after the last frame
+                 */
+                void finalize();
+                /**
+                 * @brief write all the metrics as the members of a JSON object
+                 * @param out the stream where the metrics are written
+                 */
+                void toJson(std::ostream& out) const;
+            public:
+                /**
+                 * @brief get the multiple object tracking accuracy
+                 * @return 1 - (misses + false positives + id switches) / ground truth objects
+                 */
+                inline const double
+                mota() const
+                {
+                    return (gtTotal == 0) ? 0. : 1. - double(misses + falsePositives + idSwitches) / gtTotal;
+                }
+
+                /**
+                 * @brief get the multiple object tracking precision
+                 * @return the mean distance of the matched pairs on the plan view
+                 */
+                inline const double
+                motp() const
+                {
+                    return (matches == 0) ? 0. : distances / matches;
+                }
+
+                /**
+                 * @brief get the identity F1 score, valid after finalize
+                 * @return 2 * identity true positives / (ground truth objects + tracks)
+                 */
+                inline const double
+                idf1() const
+                {
+                    return (gtTotal + hypTotal == 0) ? 0. : 2. * idtp / (gtTotal + hypTotal);
+                }
+
+                /**
+                 * @brief get the number of identity switches
+                 * @return the number of switches
+                 */
+                inline const uint
+                switches() const
+                {
+                    return idSwitches;
+                }
+            private:
+                /**
+                 * @brief compute the distance between a ground truth object and a track
+                 * @param a the ground truth object
+                 * @param b the track
+                 * @return the euclidean distance on the plan view
+                 */
+                inline const float
+                distance(const TrajectoryRecord& a, const TrajectoryRecord& b) const
+                {
+                    return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+                }
+            private:
+                float threshold;
+                uint frames;
+                uint gtTotal, hypTotal;
+                uint matches, misses, falsePositives, idSwitches;
+                double distances;
+                double idtp;
+                //last track matched to each ground truth id
+                std::map<int, int> lastMatch;
+                //frames in which a ground truth id and a track id are closer than the threshold
+                std::map< std::pair<int, int>, uint > overlaps;
+                AssignmentProblemSolver solver;
+            private:
+                static constexpr float gated_cost = 1e6;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _MULTI_HYPOTHESIS_H_
+#define _MULTI_HYPOTHESIS_H_
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+#include <opencv2/opencv.hpp>
+
+#include "track.h"
+#include "hungarianAlg.h"
+#include "frame_arena.h"
+#include "utils.h"
+
+using namespace mctracker::tracker::costs;
+using namespace mctracker::utils;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class MultiHypothesis
+        {
+            private:
+                typedef std::shared_ptr<Track> Track_ptr;
+                typedef std::vector<Track_ptr> Tracks;
+            public:
+                //maximum depth of the N-scan pruning
+                static constexpr uint max_scan = 16;
+            public:
+                /**
+                 * @brief Constructor class MultiHypothesis
+                 * @param _k the number of global hypotheses kept after each frame
+                 * @param _scan depth of the N-scan pruning: the decisions older than this number of frames are final
+                 * @param _missCost the cost of a track which is not assigned to any detection
+                 * @param _gate the maximum Mahalanobis distance between a track and an assigned detection
+                 */
+                MultiHypothesis(const uint& _k, const uint& _scan, const float& _missCost, const float& _gate);
+                /**
+                 * @brief expand each hypothesis with its k-best assignments, keep the k best ones and prune them with the N-scan: 
+                 * Murty runs on each cluster of tracks sharing gated detections and the clusters are combined
+                 * @param tracks the current tracks, already predicted
+                 * @param detections the fused detections of the current frame
+                 * @param assignment vector where the detection assigned to each track by the best hypothesis is stored, -1 if none
+                 */
+                void associate(const Tracks& tracks, const Detections& detections, assignments_t& assignment);
+                /**
+                 * @brief write the state of the best hypothesis into the tracks which took part in the association,
+                 * a different past decision of the best hypothesis corrects them
+                 * @param tracks the current tracks
+                 */
+                void commit(const Tracks& tracks);
+                /**
+                 * @brief move a track in all the hypotheses by a correction applied to its filter outside the association
+                 * (late detections), the next frame predicts from the corrected states
+                 * @param track the corrected track
+                 * @param delta the change of the state of its filter
+                 */
+                void shift(const Track_ptr& track, const cv::Matx41f& delta);
+            public:
+                /**
+                 * @brief get the number of hypotheses currently kept
+                 * @return the number of hypotheses
+                 */
+                inline const uint
+                size() const
+                {
+                    return hypotheses.size();
+                }
+            private:
+                //state of a track in a hypothesis: fixed-size matrices, no heap allocation
+                struct State
+                {
+                    cv::Matx41f x;
+                    cv::Matx44f P;
+                };
+
+                //a global hypothesis: the states of all the tracks given its assignment history
+                struct Hypothesis
+                {
+                    float cost;
+                    //ids of the tree nodes of this hypothesis in the last frames, the current one first
+                    uint64_t ancestors[max_scan + 1];
+                    State* states;
+                    int* assignment;
+                };
+
+                //a subproblem of the Murty algorithm
+                struct Node
+                {
+                    float cost;
+                    int* solution;
+                    //column forced for each row, -1 if free
+                    int* fixed;
+                    //pairs (row, column) which cannot be assigned
+                    std::pair<int, int>* excluded;
+                    uint nExcluded;
+                };
+
+                //a detection inside the gate of a track
+                struct Gate
+                {
+                    int track;
+                    int detection;
+                    float cost;
+                };
+
+                //one of the k-best assignments of a cluster, members [begin, end)
+                struct Option
+                {
+                    float cost;
+                    uint begin, end;
+                    //detection of each member, dSize + track for a miss
+                    int* assignment;
+                };
+
+                //a combination of the options of the first clusters, linked to the one it extends
+                struct Combo
+                {
+                    float cost;
+                    int prev;
+                    int option;
+                };
+
+                //an expanded hypothesis waiting for the selection
+                struct Child
+                {
+                    float cost;
+                    uint parent;
+                    int* assignment;
+                };
+            private:
+                /**
+                 * @brief align the hypotheses to the current tracks: the removed tracks are dropped and the new ones
+                 * take the state of their kalman filter
+                 * @param tracks the current tracks
+                 */
+                void sync(const Tracks& tracks);
+                /**
+                 * @brief find the root of a track in the union-find of the clusters
+                 * @param i the track
+                 * @return the root of its cluster
+                 */
+                int find(int i);
+                /**
+                 * @brief group the tracks with gated detections into clusters, the members are sorted by cluster
+                 * @param tSize the number of tracks
+                 * @param dSize the number of detections
+                 */
+                void partition(const uint& tSize, const uint& dSize);
+                /**
+                 * @brief compute the k-best assignments of a cluster and store them as options
+                 * @param begin the first member of the cluster
+                 * @param end the member after the last one
+                 * @param dSize the number of detections
+                 */
+                void expand(const uint& begin, const uint& end, const uint& dSize);
+                /**
+                 * @brief compute the k-best assignments of a cost matrix with the Murty algorithm
+                 * @param cost the cost matrix, column major (row + col * rows)
+                 * @param rows number of rows (tracks)
+                 * @param cols number of columns (detections and one miss column for each track)
+                 * @param k the number of assignments
+                 * @param solutions vector where the assignments are stored, sorted by cost
+                 */
+                void kbest(const distMatrix_t& cost, const uint& rows, const uint& cols, const uint& k, std::vector<Node>& solutions);
+                /**
+                 * @brief solve a subproblem of the Murty algorithm
+                 * @param cost the cost matrix of the problem
+                 * @param rows number of rows
+                 * @param cols number of columns
+                 * @param node the subproblem, its solution and cost are filled
+                 * @return true if the subproblem has a feasible solution
+                 */
+                bool solve(const distMatrix_t& cost, const uint& rows, const uint& cols, Node& node);
+                /**
+                 * @brief allocate an array from an arena
+                 * @param arena the arena
+                 * @param n the number of elements
+                 * @return a pointer to the array
+                 */
+                template<typename T>
+                inline T*
+                allocate(FrameArena& arena, const size_t& n)
+                {
+                    return static_cast<T*>(arena.allocate(std::max(n, size_t(1)) * sizeof(T), alignof(T)));
+                }
+            private:
+                uint k;
+                uint scan;
+                float missCost;
+                float gate;
+                uint64_t nodes;
+                //the hypotheses of the current frame live in arenas[current], the new ones are built in the other one
+                FrameArena arenas[2];
+                int current;
+                //temporaries of an association
+                FrameArena scratch;
+                std::vector<Hypothesis> hypotheses, survivors;
+                std::vector<Child> children;
+                //predicted states of the tracks in each hypothesis
+                std::vector<State*> predictions;
+                std::vector<Node> queue, solutions;
+                //gated pairs of the hypothesis being expanded, the ones of the track i start at first[i]
+                std::vector<Gate> gated;
+                std::vector<int> first;
+                //clusters: union-find over the tracks, the members are the tracks with gated detections sorted by cluster
+                std::vector<int> parent, owner, roots, members;
+                //column of each detection in the matrix of the current cluster, -1 outside it
+                std::vector<int> columns, clusterDetections;
+                std::vector<Option> options;
+                std::vector<int> optionFirst;
+                std::vector<Combo> combos, candidates;
+                std::vector<int> frontier;
+                //serials of the tracks in the order of the states of the hypotheses, a recycled track is a new one
+                std::vector<uint64_t> order;
+                std::unordered_map<uint64_t, int> index;
+                distMatrix_t costs, work;
+                assignments_t assignments;
+                AssignmentProblemSolver solver;
+            private:
+                static constexpr float forbidden = 1e6;
+        };
+    }
+}
+
+#endif
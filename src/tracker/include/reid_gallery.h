@@ -0,0 +1,111 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _REID_GALLERY_H_
+#define _REID_GALLERY_H_
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <opencv2/opencv.hpp>
+
+#include "appearance.h"
+#include "hnsw_index.h"
+#include "tracker_clock.h"
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class ReidGallery
+        {
+            public:
+                /**
+                 * @brief Constructor class ReidGallery
+                 * @param _capacity the maximum number of identities kept, the oldest one is dropped when it is full
+                 * @param _ttl the time in seconds after which a lost identity cannot be revived
+                 * @param _threshold the minimum appearance similarity for reviving an identity
+                 * @param _speed the maximum speed of a lost identity in plan view pixels per second
+                 * @param _links the number of links of each node of the appearance index
+                 * @param _efConstruction the size of the candidate list used for inserting into the appearance index
+                 * @param _efSearch the size of the candidate list of the appearance queries
+                 */
+                ReidGallery(const uint& _capacity, const double& _ttl, const float& _threshold, const float& _speed, 
+                            const uint& _links, const uint& _efConstruction, const uint& _efSearch);
+                /**
+                 * @brief store the identity of a lost track
+                 * @param label the label of the track
+                 * @param color the color of the track
+                 * @param hist the hsv histogram of the track
+                 * @param position the last position of the track on the plan view
+                 */
+                void insert(const int& label, const cv::Scalar& color, const cv::Mat& hist, const cv::Point2f& position);
+                /**
+                 * @brief look for the lost identity most similar to a new track among the ones which could have 
+                 * walked to it since they were lost, the identity found leaves the gallery
+                 * @param hist the hsv histogram of the new track
+                 * @param position the position of the new track on the plan view
+                 * @param label where the label of the identity is stored
+                 * @param color where the color of the identity is stored
+                 * @return true if an identity is similar enough
+                 */
+                bool revive(const cv::Mat& hist, const cv::Point2f& position, int& label, cv::Scalar& color);
+                /**
+                 * @brief drop the identities older than the time to live
+                 */
+                void expire();
+            public:
+                /**
+                 * @brief get the number of identities in the gallery
+                 * @return the number of identities
+                 */
+                inline const uint
+                size() const
+                {
+                    return count;
+                }
+            private:
+                //a lost identity
+                struct Entry
+                {
+                    int label;
+                    cv::Scalar color;
+                    //where and when the identity was lost
+                    cv::Point2f position;
+                    double time;
+                    bool used;
+                    //insertion stamp, it tells a reused slot from the identity queued before
+                    uint64_t stamp;
+                };
+            private:
+                /**
+                 * @brief remove an identity from the gallery and from the index
+                 * @param slot the slot of the identity
+                 */
+                void erase(const int& slot);
+            private:
+                uint capacity;
+                double ttl;
+                float threshold;
+                float speed;
+                uint count;
+                std::vector<Entry> entries;
+                std::vector<int> freeSlots;
+                //slots in insertion order, the ones removed by a revival are skipped
+                std::deque< std::pair<int, uint64_t> > fifo;
+                uint64_t stamps;
+                //appearance index of the identities, keyed by slot
+                HnswIndex index;
+                std::vector<HnswIndex::Neighbor> results;
+                Appearance::Descriptor descriptor;
+            private:
+                //most similar identities checked for a plausible motion
+                static constexpr uint candidates = 4;
+                //distance on the plan view allowed whatever the elapsed time, it absorbs the position noise
+                static constexpr float min_radius = 30;
+        };
+    }
+}
+
+#endif
@@ -8,11 +8,14 @@
 
 #include <iostream>
 #include <memory>
+#include <atomic>
 
 #include "utils.h"
 #include "entity.h"
 #include "kalman.h"
 #include "kalman_param.h"
+#include "trajectory_log.h"
+#include "tracker_clock.h"
 
 using namespace mctracker::config;
 
@@ -23,6 +26,7 @@ namespace mctracker
         class Track : public Entity
         {
             friend class Tracker;
+            friend class ImmBank;
             
             public:
                 /**
@@ -38,6 +42,15 @@ namespace mctracker
                  * @param cameraNum number of cameras of the system
                  */
                 Track(const float& _x, const float& _y, const KalmanParam& _param, const cv::Mat& _h, const int cameraNum);
+                /**
+                 * @brief reinitialize the track in place, the kalman filter and the histogram buffers are reused
+                 * @param _x x-coordinate of the current detection
+                 * @param _y y-coordinate of the current detection
+                 * @param _param kalaman filter params
+                 * @param _h hsv histogram of the current detection
+                 * @param cameraNum number of cameras of the system
+                 */
+                void init(const float& _x, const float& _y, const KalmanParam& _param, const cv::Mat& _h, const int cameraNum);
                 /**
                  * @brief get the last prediction
                  * @return the last predition of the kalman filter
@@ -53,12 +66,29 @@ namespace mctracker
                 {
                     return m_label;
                 }
+                
+                /**
+                 * @brief get the serial number of the track, unique in the process also when the track is recycled
+                 * @return the serial number
+                 */
+                inline const uint64_t 
+                serial() const
+                {
+                    return m_serial;
+                }
             protected:
                 /**
                  * @brief preditction step of the kalman filter
                  * @return a cv::Mat containing the prediction
                  */
                 const cv::Mat predict();
+                /**
+                 * @brief prediction step computed outside the kalman filter (interacting multiple models)
+                 * @param x the predicted state [x, y, vx, vy]
+                 * @param P the predicted covariance
+                 * @return a cv::Mat containing the prediction
+                 */
+                const cv::Mat predict(const cv::Matx41f& x, const cv::Matx44f& P);
                  /**
                  * @brief correction step of the kalman filter
                  * @param _x x-coordinate of the current detection
@@ -66,6 +96,14 @@ namespace mctracker
                  * @return  cv::Mat containing the corrected prediction
                  */
                 const cv::Mat correct(const float& _x, const float& _y);
+                /**
+                 * @brief out-of-sequence correction of the kalman filter with a late detection
+                 * @param _x x-coordinate of the late detection
+                 * @param _y y-coordinate of the late detection
+                 * @param lag time elapsed between the acquisition of the detection and the current state
+                 * @return  cv::Mat containing the corrected state
+                 */
+                const cv::Mat correctLate(const float& _x, const float& _y, const float& lag);
                 /**
                  * @brief update the kalman filter considering all the observation of the same detection
                  * @return a cv::Mat containing the corrected prediction
@@ -153,6 +191,11 @@ namespace mctracker
                     points.push_back(p);
                 }
                 
+                /**
+                 * @brief store the whole history of the track in the trajectory log
+                 */
+                void spill();
+                
                 /**
                  * @brief set the hsv histogram of the track
                  * @param h a cv::Mat containing the hsv histogram
@@ -160,7 +203,8 @@ namespace mctracker
                 void 
                 set_hist(const cv::Mat& h)
                 {
-                    hist = h;
+                    //the buffer is owned by the track so that it can be recycled
+                    h.copyTo(hist);
                 }
             private:
                 /**
@@ -168,12 +212,23 @@ namespace mctracker
                  * @return a string containin the id of the track
                  */
                 const std::string label2string();
+                /**
+                 * @brief add the predicted position to the history, the evicted one is written to the trajectory log
+                 * @param prediction the prediction of the kalman filter
+                 */
+                void record(const cv::Mat& prediction);
+            private:
+                //one fused detection is expected for each update
+                constexpr static uint max_points = 10;
+            private:
+                static std::atomic<uint64_t> serials;
             private:
                 int m_label;
+                uint64_t m_serial;
                 uint ntimes_propagated;
                 uint freezed;
                 double time;
-                std::vector<cv::Point2f> points;
+                RingBuffer<cv::Point2f, max_points> points;
                 double time_in_sec;
                 uint ntime_missed;
                 cv::Mat hist;
@@ -0,0 +1,114 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _TRACK_POOL_H_
+#define _TRACK_POOL_H_
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <opencv2/opencv.hpp>
+
+#include "track.h"
+#include "kalman_param.h"
+
+using namespace mctracker::config;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        class TrackPool
+        {
+            public:
+                typedef std::shared_ptr<Track> Track_ptr;
+            public:
+                static std::shared_ptr<TrackPool> instance();
+                /**
+                 * @brief get a track from the pool, when the last reference is released the track goes back to the pool
+                 * @param _x x-coordinate of the current detection
+                 * @param _y y-coordinate of the current detection
+                 * @param _param kalaman filter params
+                 * @param _h hsv histogram of the current detection
+                 * @param cameraNum number of cameras of the system
+                 * @return a pointer to the initialized track
+                 */
+                Track_ptr acquire(const float& _x, const float& _y, const KalmanParam& _param, const cv::Mat& _h, const int cameraNum);
+                /**
+                 * @brief print the occupancy of the pool
+                 */
+                void print();
+            public:
+                /**
+                 * @brief get the number of tracks allocated by the pool
+                 * @return the number of tracks
+                 */
+                inline const size_t
+                capacity() const
+                {
+                    return storage->capacity;
+                }
+
+                /**
+                 * @brief get the number of tracks currently in use
+                 * @return the number of tracks
+                 */
+                inline const size_t
+                inUse() const
+                {
+                    return storage->used;
+                }
+
+                /**
+                 * @brief get the maximum number of tracks used at the same time
+                 * @return the number of tracks
+                 */
+                inline const size_t
+                peak() const
+                {
+                    return storage->peak;
+                }
+
+                /**
+                 * @brief get the number of tracks served by recycling a released one
+                 * @return the number of tracks
+                 */
+                inline const size_t
+                recycled() const
+                {
+                    return storage->recycled;
+                }
+            private:
+                //the slabs are shared with the deleters: a track released after the pool is still returned safely
+                struct Storage
+                {
+                    std::vector< std::unique_ptr<Track[]> > slabs;
+                    std::vector<Track*> freeTracks;
+                    size_t capacity = 0;
+                    size_t used = 0;
+                    size_t peak = 0;
+                    size_t recycled = 0;
+                    size_t fresh = 0;
+                    std::mutex mtx;
+                };
+            private:
+                /**
+                 * @brief Constructor class TrackPool
+                 */
+                TrackPool() : storage(new Storage) { ; }
+                /**
+                 * @brief allocate a new slab of tracks
+                 */
+                void grow();
+            private:
+                static std::shared_ptr<TrackPool> m_instance;
+                std::shared_ptr<Storage> storage;
+            private:
+                static constexpr size_t slab_size = 64;
+        };
+    }
+}
+
+#endif
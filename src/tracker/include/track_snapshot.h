@@ -0,0 +1,110 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _TRACK_SNAPSHOT_H_
+#define _TRACK_SNAPSHOT_H_
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+#include "drawing.h"
+#include "camera.h"
+#include "entity.h"
+
+using namespace mctracker::utils;
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        //plain state of a track: it can be copied and read without touching the tracker
+        struct TrackState
+        {
+            static const int max_cameras = 10;
+            //the whole history a track can keep (HISTORY is at most this capacity)
+            static const int max_history = Entity::max_history;
+
+            int label;
+            float x, y;
+            float vx, vy;
+            unsigned char color[3];
+            bool good;
+            int missed;
+            //size of the bounding box in each view, width 0 if not seen
+            int widths[max_cameras];
+            int heights[max_cameras];
+            //last predicted positions, the oldest first
+            float history[max_history][2];
+            int historySize;
+        };
+
+        class TrackSnapshot
+        {
+            //the tracker refills the snapshots which no reader holds anymore
+            friend class Tracker;
+            public:
+                /**
+                 * @brief Constructor class TrackSnapshot
+                 * @param frame the index of the frame the snapshot refers to
+                 * @param timestamp the time of the tracker state
+                 * @param states the states of all the tracks
+                 */
+                TrackSnapshot(const uint64_t& frame, const double& timestamp, std::vector<TrackState>&& states)
+                    : m_frame(frame), m_timestamp(timestamp), m_states(std::move(states)) { ; }
+                /**
+                 * @brief draw the accepted tracks in all the camera views projecting all their points at once
+                 * @param images a vector containing the frames of all the cameras
+                 * @param cameras a vector containing all the camera infos
+                 */
+                void draw(std::vector<cv::Mat>& images, const std::vector<Camera>& cameras) const;
+                /**
+                 * @brief draw the accepted tracks on the planview
+                 * @param img cv::Mat containing the plan view
+                 * @param history boolean: if true the history of the tracks is drawed
+                 */
+                void drawPlanView(cv::Mat& img, bool history = true) const;
+            public:
+                /**
+                 * @brief get the index of the frame the snapshot refers to
+                 * @return the index of the frame
+                 */
+                inline const uint64_t
+                frame() const
+                {
+                    return m_frame;
+                }
+
+                /**
+                 * @brief get the time of the tracker state
+                 * @return the timestamp
+                 */
+                inline const double
+                timestamp() const
+                {
+                    return m_timestamp;
+                }
+
+                /**
+                 * @brief get the states of all the tracks
+                 * @return a vector containing the states
+                 */
+                inline const std::vector<TrackState>&
+                states() const
+                {
+                    return m_states;
+                }
+            private:
+                uint64_t m_frame;
+                double m_timestamp;
+                std::vector<TrackState> m_states;
+        };
+
+        typedef std::shared_ptr<const TrackSnapshot> Snapshot_ptr;
+    }
+}
+
+#endif
@@ -11,6 +11,9 @@
 #include <vector>
 #include <functional>
 #include <iterator>
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
 
 #include "entity.h"
 #include "kalman_param.h"
@@ -20,6 +23,17 @@
 #include "hungarianAlg.h"
 #include "utils.h"
 #include "camera.h"
+#include "fovmap.h"
+#include "track_snapshot.h"
+#include "track_pool.h"
+#include "frame_arena.h"
+#include "tracker_clock.h"
+#include "detection_log.h"
+#include "multi_hypothesis.h"
+#include "jpda.h"
+#include "imm_bank.h"
+#include "reid_gallery.h"
+#include "hnsw_index.h"
 
 using namespace mctracker::utils;
 using namespace mctracker::config;
@@ -39,9 +53,11 @@ namespace mctracker
             private:
                 typedef std::shared_ptr<Track> Track_ptr;
                 typedef std::vector<Track_ptr> Tracks;
+                typedef FrameVector< std::pair<int, int> > Cluster; //camera, idx_detection
             public:
                 /**
-                 * @brief Constructor class Tracker
+                 * @brief Constructor class Tracker, it sets the mode of the process-wide TrackerClock from the
+                 * deterministic parameter
                  * @param _param kalaman parameters
                  * @param camerastack the camera stack stack 
                  */
@@ -51,8 +67,18 @@ namespace mctracker
                  * @param _detections the current detections coming from all the cameras
                  * @param w width of the tracking space
                  * @param h height of the tracking space
+                 * @param timestamp the acquisition time of the detections in seconds, if negative the dt of the configuration is used
                  */
-                void track(std::vector<Detections>& _detections,  const int& w, const int& h);
+                void track(std::vector<Detections>& _detections,  const int& w, const int& h, const double& timestamp = -1);
+                /**
+                 * @brief track the detections of unsynchronised cameras: the detections acquired before the newest camera 
+                 * are applied with an out-of-sequence update after the current one
+                 * @param _detections the current detections coming from all the cameras
+                 * @param w width of the tracking space
+                 * @param h height of the tracking space
+                 * @param timestamps the acquisition time of the detections of each camera in seconds
+                 */
+                void track(std::vector<Detections>& _detections,  const int& w, const int& h, const std::vector<double>& timestamps);
             public:
                 /**
                  * @brief set the tracking space size
@@ -68,36 +94,68 @@ namespace mctracker
                 
                 /**
                  * @brief evolve the tracks in order to compute the predictions
+                 * @param dt the time elapsed from the last prediction
                  */
                 inline const void 
-                evolveTracks()
+                evolveTracks(const float& dt)
                 {
                     for(const auto& track : single_tracks)
                     {
-                        track->predict();
+                        track->setDt(dt);
+                        if(!imm)
+                            track->predict();
                     }
+                    
+                    //the interacting multiple models predict all the tracks at once
+                    if(imm)
+                        imm->predict(single_tracks);
                 }
                 
                 /**
-                 * @brief get the current tracks
+                 * @brief get the current tracks, they are the live objects updated by the tracker
                  * @return a vector containing the tracks
                  */
                 const Entities getTracks();
+                
+                /**
+                 * @brief get the last published snapshot of the tracks, it can be called from any thread while tracking: 
+                 * the swap of the pointer takes a short lock inside the standard library (std::atomic_load and std::atomic_store 
+                 * of a shared_ptr are not lock-free), but a reader never waits for the tracker to process a frame
+                 * @return a pointer to the immutable snapshot (null before the first frame)
+                 */
+                inline Snapshot_ptr
+                getSnapshot() const
+                {
+                    return std::atomic_load(&snapshot);
+                }
+                
+                /**
+                 * @brief get the arena of the temporaries of a tracking step
+                 * @return the arena
+                 */
+                inline const FrameArena&
+                getArena() const
+                {
+                    return arena;
+                }
             private:
                 
                 /**
                  * @brief compute the association between the detections and the tracks
                  * @param _detections a vector containing all the detections
-                 * @retun a cv::Mat containing the association track-detection
+                 * @param assignment vector where the detection assigned to each track is stored, -1 if none
                  */
-                cv::Mat associate_tracks(const Detections& _detections);
+                void associate_tracks(const Detections& _detections, assignments_t& assignment);
                 
                 /**
                  * @brief update the tracks 
-                 * @param assigments a vector containing the assigments between the detections of each camera and the old tracks
+                 * @param assignment the fused detection assigned to each track, -1 if none
+                 * @param detections a vector containing the fused detections
+                 * @param clusters the camera detections which compose each fused detection
                  * @param _detections a vector containing all the detections
                  */
-                void update_tracks(const std::vector<cv::Mat>& assigments, const std::vector<Detections>& _detections);
+                void update_tracks(const assignments_t& assignment, const Detections& detections, const FrameVector<Cluster>& clusters, 
+                                   const std::vector<Detections>& _detections);
                 
                 /**
                  * @brief delete/freeze the tracks for which no detections are available
@@ -109,6 +167,16 @@ namespace mctracker
                  * @param _detections a vector containing all the detections
                  */
                 void check_old_tracks(std::vector< Detections >& _detections);
+                /**
+                 * @brief freeze a track: it is moved to the old tracks and its appearance is indexed when the nearest neighbours are used
+                 * @param track the track
+                 */
+                void freeze(const Track_ptr& track);
+                /**
+                 * @brief remove an old track and its appearance from the index, the last old track takes its position
+                 * @param id the position of the track in the old tracks
+                 */
+                void unfreeze(const int& id);
                 
                 /**
                  * @brief refine the input detections
@@ -117,11 +185,41 @@ namespace mctracker
                 void refine_detections(std::vector<Detections>& _detections);
                 
                 /**
-                 * @brief compute the first association between cameras 
+                 * @brief compute the dt of the kalman filters from the elapsed time
+                 * @param timestamp the acquisition time of the current detections in seconds
+                 * @return the value of dt, 0 if the timestamp is not newer than the last one
+                 */
+                float elapsed(const double& timestamp);
+                
+                /**
+                 * @brief predict, associate and update the tracks with the current detections
+                 * @param _detections the current detections coming from all the cameras
+                 * @param w width of the tracking space
+                 * @param h height of the tracking space
+                 * @param timestamp the acquisition time of the detections in seconds
+                 */
+                void step(std::vector<Detections>& _detections,  const int& w, const int& h, const double& timestamp);
+                
+                /**
+                 * @brief copy the state of the tracks into a snapshot no reader holds and publish it for the readers
+                 * @param timestamp the time of the tracker state
+                 */
+                void publish(const double& timestamp);
+                
+                /**
+                 * @brief apply the late detections of a camera to the tracks with an out-of-sequence update
+                 * @param late the detections of the camera
+                 * @param lag time elapsed between the acquisition of the detections and the current state
+                 */
+                void correct_late(const Detections& late, const float& lag);
+                
+                /**
+                 * @brief fuse the detections of all the cameras into a single measurement per object
                  * @param _detections a vector containing all the detections
-                 * @return a vector containing the associated points
+                 * @param clusters vector where the camera detections composing each fused detection are stored
+                 * @param detections vector where the fused detections are stored
                  */
-                Detections first_assosiation(std::vector<Detections>& _detections);
+                void fuse_detections(const std::vector<Detections>& _detections, FrameVector<Cluster>& clusters, Detections& detections);
             private:
                 KalmanParam param;
                 Detections last_detection;
@@ -133,14 +231,53 @@ namespace mctracker
                 cv::RNG rng;
                 uint trackIds;
                 std::vector<Camera> streams;
+                FovMap fovMap;
                 //storing the probabilities of the camera system
                 //each value represensts: 
                 //  -prob that the obs is in the FOV of all the cameras given the proximity of the camera
                 std::vector<float > cameraProbabilities; 
                 int numCams;
+                double last_timestamp;
+                //the readers keep the snapshot they loaded alive, the tracker swaps in the new one
+                Snapshot_ptr snapshot;
+                //all the snapshots ever allocated, the ones held only here are refilled
+                std::vector< std::shared_ptr<TrackSnapshot> > snapshots;
+                uint64_t frames;
+                //the temporaries of a frame are taken from the arena, the buffers below keep their capacity among the frames;
+                //the heap is still used by the index nodes of the tracks which freeze and by the new track hypotheses (Hyphothesis)
+                FrameArena arena;
+                AssignmentProblemSolver solver;
+                distMatrix_t cost_buffer;
+                assignments_t assignment_buffer;
+                assignments_t track_assignment;
+                Detections fused_detections;
+                //detections of the cameras behind the newest one
+                std::vector<Detections> late_detections;
+                DetectionLog recorder;
+                //multi-hypothesis association, null in GNN mode
+                std::shared_ptr<MultiHypothesis> mht;
+                //joint probabilistic association, null in the other modes
+                std::shared_ptr<Jpda> jpda;
+                //interacting multiple models of the tracks, null with the constant velocity model
+                std::shared_ptr<ImmBank> imm;
+                //identities of the lost tracks, null when the re-identification is disabled
+                std::shared_ptr<ReidGallery> gallery;
+                //appearance index of the frozen tracks, keyed by an id given when they freeze
+                HnswIndex frozen;
+                //index id of each frozen track by serial, and position in old_tracks of each index id
+                std::unordered_map<uint64_t, int> frozen_keys;
+                std::unordered_map<int, int> frozen_index;
+                int frozenIds;
+                Appearance::Descriptor descriptor;
+                std::vector<HnswIndex::Neighbor> neighbors;
             private:
                 static constexpr float freezed_thresh = 0.4;
                 static constexpr uint association_thresh = 40;
+                static constexpr float gated_cost = 1e6;
+                //mahalanobis distance within which a frozen track outside the appearance neighbours is still compared
+                static constexpr float near_gate = 3;
+                //late detections older than this number of nominal frames are discarded
+                static constexpr float max_lag = 5;
         };
     }
 }
@@ -0,0 +1,60 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _TRACKER_CLOCK_H_
+#define _TRACKER_CLOCK_H_
+
+#include <iostream>
+#include <memory>
+#include <opencv2/opencv.hpp>
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        //time source of the tracks, shared by the whole process: the last tracker constructed sets its mode,
+        //so the trackers of a process have to agree on the deterministic mode
+        class TrackerClock
+        {
+            public:
+                static std::shared_ptr<TrackerClock> instance();
+                /**
+                 * @brief get the current time
+                 * @return the time in seconds, from the wall clock or the last time set in manual mode
+                 */
+                double now() const;
+                /**
+                 * @brief enable the manual mode: the time is injected by the tracker instead of read from the wall clock
+                 * @param enable bool, true for enabling the manual mode
+                 */
+                void setManual(const bool& enable);
+                /**
+                 * @brief set the current time, it is used only in manual mode
+                 * @param t the time in seconds
+                 */
+                void set(const double& t);
+            public:
+                /**
+                 * @brief check if the manual mode is enabled
+                 * @return true if the time is injected
+                 */
+                inline const bool
+                isManual() const
+                {
+                    return manual;
+                }
+            private:
+                /**
+                 * @brief Constructor class TrackerClock
+                 */
+                TrackerClock() : manual(false), current(0) { ; }
+            private:
+                static std::shared_ptr<TrackerClock> m_instance;
+                bool manual;
+                double current;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _TRAJECTORY_LOG_H_
+#define _TRAJECTORY_LOG_H_
+
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+namespace mctracker
+{
+    namespace tracker
+    {
+        //compact record of the log: a position of a track at a given frame
+        struct TrajectoryRecord
+        {
+            int32_t label;
+            uint32_t frame;
+            float x, y;
+        };
+
+        class TrajectoryLog
+        {
+            public:
+                static std::shared_ptr<TrajectoryLog> instance();
+                /**
+                 * @brief Destructor class TrajectoryLog: the pending records are written
+                 */
+                ~TrajectoryLog();
+                /**
+                 * @brief open the binary file where the trajectories are stored
+                 * @param file the path to the file
+                 */
+                void open(const std::string& file);
+                /**
+                 * @brief set the current frame of the tracker
+                 * @param _frame the index of the frame
+                 */
+                void setFrame(const uint32_t& _frame);
+                /**
+                 * @brief store a position of a track
+                 * @param label the id of the track
+                 * @param age the number of frames elapsed since the position has been predicted
+                 * @param p the position on the plan view
+                 */
+                void write(const int& label, const uint32_t& age, const cv::Point2f& p);
+                /**
+                 * @brief write the pending records to the file
+                 */
+                void flush();
+                /**
+                 * @brief read a trajectory log
+                 * @param file the path to the file
+                 * @param records vector where the records are stored
+                 * @return true if the file is a valid trajectory log, false otherwise
+                 */
+                static bool read(const std::string& file, std::vector<TrajectoryRecord>& records);
+                /**
+                 * @brief write a set of records as a trajectory log
+                 * @param file the path to the file
+                 * @param records the records to store
+                 */
+                static void save(const std::string& file, const std::vector<TrajectoryRecord>& records);
+            public:
+                /**
+                 * @brief check if the log is enabled
+                 * @return true if a file is open
+                 */
+                inline const bool
+                isOpen() const
+                {
+                    return out.is_open();
+                }
+            private:
+                /**
+                 * @brief Constructor class TrajectoryLog
+                 */
+                TrajectoryLog() : frame(0) { ; }
+            private:
+                static std::shared_ptr<TrajectoryLog> m_instance;
+                std::ofstream out;
+                uint32_t frame;
+                std::vector<TrajectoryRecord> pending;
+            private:
+                static constexpr uint32_t magic = 0x4c54434d; //MCTL
+                static constexpr size_t flush_size = 4096;
+        };
+    }
+}
+
+#endif
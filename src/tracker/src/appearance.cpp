@@ -0,0 +1,44 @@
+#include "appearance.h"
+
+using namespace mctracker::tracker;
+
+void
+Appearance::describe(const cv::Mat& hist, Descriptor& d)
+{
+    d.fill(0.f);
+    if(hist.empty())
+    {
+        return;
+    }
+
+    //the pooled histogram is written directly into the descriptor
+    cv::Mat pooled(hue_cells, sat_cells, CV_32FC1, d.data());
+    cv::resize(hist, pooled, pooled.size(), 0, 0, cv::INTER_AREA);
+
+    float mean = 0;
+    for(const auto& v : d)
+    {
+        mean += v;
+    }
+    mean /= size;
+
+    float norm = 0;
+    for(auto& v : d)
+    {
+        v -= mean;
+        norm += v * v;
+    }
+
+    //a flat histogram carries no appearance
+    if(norm <= 0)
+    {
+        d.fill(0.f);
+        return;
+    }
+
+    norm = 1.f / std::sqrt(norm);
+    for(auto& v : d)
+    {
+        v *= norm;
+    }
+}
@@ -0,0 +1,130 @@
+#include "detection_log.h"
+
+using namespace mctracker::tracker;
+
+template<typename T>
+static void
+put(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool
+get(std::ifstream& in, T& value)
+{
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+void
+DetectionLog::create(const std::string& file)
+{
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if(!out.is_open())
+    {
+        throw std::invalid_argument("Invalid detection log file: " + file);
+    }
+    put(out, magic);
+}
+
+void
+DetectionLog::open(const std::string& file)
+{
+    in.open(file, std::ios::binary);
+    uint32_t header = 0;
+    if(!in.is_open() || !get(in, header) || header != magic)
+    {
+        throw std::invalid_argument("Invalid detection log file: " + file);
+    }
+}
+
+void
+DetectionLog::write(const std::vector<Detections>& _detections, const std::vector<double>& timestamps, const int& w, const int& h)
+{
+    if(!out.is_open())
+    {
+        return;
+    }
+
+    put(out, int32_t(w));
+    put(out, int32_t(h));
+    put(out, uint32_t(timestamps.size()));
+    for(const auto& t : timestamps)
+    {
+        put(out, t);
+    }
+
+    put(out, uint32_t(_detections.size()));
+    for(const auto& det : _detections)
+    {
+        put(out, uint32_t(det.size()));
+        for(const auto& d : det)
+        {
+            put(out, d.x());
+            put(out, d.y());
+            put(out, d.w());
+            put(out, d.h());
+
+            //the histogram is stored with its raw bytes: the replay is bit exact
+            const cv::Mat& hist = d.hist().isContinuous() ? d.hist() : d.hist().clone();
+            put(out, int32_t(hist.rows));
+            put(out, int32_t(hist.cols));
+            put(out, int32_t(hist.type()));
+            out.write(reinterpret_cast<const char*>(hist.data), hist.total() * hist.elemSize());
+        }
+    }
+    out.flush();
+}
+
+bool
+DetectionLog::read(std::vector<Detections>& _detections, std::vector<double>& timestamps, int& w, int& h)
+{
+    int32_t width, height;
+    uint32_t size;
+    if(!get(in, width) || !get(in, height) || !get(in, size))
+    {
+        return false;
+    }
+    w = width;
+    h = height;
+
+    timestamps.resize(size);
+    for(auto& t : timestamps)
+    {
+        get(in, t);
+    }
+
+    get(in, size);
+    _detections.resize(size);
+    for(auto& det : _detections)
+    {
+        det.clear();
+        get(in, size);
+        for(uint32_t i = 0; i < size; ++i)
+        {
+            float x, y, dw, dh;
+            int32_t rows, cols, type;
+            get(in, x);
+            get(in, y);
+            get(in, dw);
+            get(in, dh);
+            get(in, rows);
+            get(in, cols);
+            get(in, type);
+
+            cv::Mat hist;
+            if(rows * cols > 0)
+            {
+                hist.create(rows, cols, type);
+                in.read(reinterpret_cast<char*>(hist.data), hist.total() * hist.elemSize());
+            }
+            det.push_back(Detection(x, y, dw, dh, hist));
+        }
+    }
+
+    if(!in)
+    {
+        throw std::invalid_argument("Truncated detection log");
+    }
+    return true;
+}
@@ -0,0 +1,42 @@
+#include "fovmap.h"
+
+using namespace mctracker::tracker;
+
+FovMap
+::FovMap(const std::vector<Camera>& cameras)
+    : rows(0), cols(0)
+{
+    if(cameras.size() > sizeof(ushort) * 8)
+    {
+        throw std::invalid_argument("Too many cameras for the fov map");
+    }
+    
+    for(const auto& camera : cameras)
+    {
+        const auto& fov = camera.getFOV();
+        rows = std::max(rows, fov.rows);
+        cols = std::max(cols, fov.cols);
+    }
+    
+    coverage.assign(rows * cols, 0);
+    
+    auto m = 0;
+    for(const auto& camera : cameras)
+    {
+        const auto& fov = camera.getFOV();
+        const ushort bit = 1 << m;
+        for(auto i = 0; i < fov.rows; ++i)
+        {
+            const uchar* row = fov.ptr<uchar>(i);
+            ushort* cells = &coverage[i * cols];
+            for(auto j = 0; j < fov.cols; ++j)
+            {
+                if(row[j] == 255)
+                {
+                    cells[j] |= bit;
+                }
+            }
+        }
+        ++m;
+    }
+}
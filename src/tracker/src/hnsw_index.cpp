@@ -0,0 +1,365 @@
+#include "hnsw_index.h"
+
+using namespace mctracker::tracker;
+
+HnswIndex
+::HnswIndex(const uint& _m, const uint& _efConstruction, const uint& _efSearch)
+    : m(_m), efConstruction(_efConstruction), efSearch(_efSearch), rng(0x4e5357), entry(-1), maxLevel(-1), count(0), visit(0)
+{
+    if(m < 2)
+    {
+        m = 2;
+    }
+    if(efConstruction < m)
+    {
+        efConstruction = m;
+    }
+    ml = 1. / std::log(double(m));
+}
+
+void
+HnswIndex::insert(const int& id, const Descriptor& d)
+{
+    if(contains(id))
+    {
+        erase(id);
+    }
+
+    //the slots of the removed nodes are reused with their link buffers
+    int slot;
+    if(freeSlots.size() > 0)
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        slot = nodes.size();
+        nodes.push_back(Node());
+    }
+
+    int level = int(-std::log(1. - rng.uniform(0., 1.)) * ml);
+    if(level > max_level)
+    {
+        level = max_level;
+    }
+
+    auto& node = nodes.at(slot);
+    node.id = id;
+    node.level = level;
+    node.used = true;
+    node.d = d;
+    node.links.resize(level + 1);
+    node.inbound.resize(level + 1);
+    for(int l = 0; l <= level; ++l)
+    {
+        node.links.at(l).clear();
+        node.inbound.at(l).clear();
+    }
+    slots[id] = slot;
+    count++;
+
+    if(entry == -1)
+    {
+        entry = slot;
+        maxLevel = level;
+        return;
+    }
+
+    //descend to the layer of the node, then link it layer by layer
+    int ep = entry;
+    for(int l = maxLevel; l > level; --l)
+    {
+        ep = greedy(d, ep, l);
+    }
+
+    for(int l = std::min(level, maxLevel); l >= 0; --l)
+    {
+        search_layer(d, ep, efConstruction, l, found);
+        ep = found.at(0).second;
+
+        selected.assign(found.begin(), found.end());
+        select_neighbors(selected, m);
+        for(const auto& s : selected)
+        {
+            connect(slot, s.second, l);
+            connect(s.second, slot, l);
+            if(nodes.at(s.second).links.at(l).size() > maxLinks(l))
+            {
+                shrink(s.second, l);
+            }
+        }
+    }
+
+    if(level > maxLevel)
+    {
+        entry = slot;
+        maxLevel = level;
+    }
+}
+
+void
+HnswIndex::erase(const int& id)
+{
+    const auto& it = slots.find(id);
+    if(it == slots.end())
+    {
+        return;
+    }
+    const int slot = it->second;
+    slots.erase(it);
+
+    auto& node = nodes.at(slot);
+    for(int l = 0; l <= node.level; ++l)
+    {
+        //the neighbours of the node are given to the nodes which pointed to it
+        repair.assign(node.links.at(l).begin(), node.links.at(l).end());
+        for(const auto& n : repair)
+        {
+            disconnect(slot, n, l);
+        }
+
+        linking.assign(node.inbound.at(l).begin(), node.inbound.at(l).end());
+        for(const auto& u : linking)
+        {
+            disconnect(u, slot, l);
+        }
+
+        for(const auto& u : linking)
+        {
+            for(const auto& n : repair)
+            {
+                if(n != u)
+                {
+                    connect(u, n, l);
+                }
+            }
+            if(nodes.at(u).links.at(l).size() > maxLinks(l))
+            {
+                shrink(u, l);
+            }
+        }
+    }
+
+    node.used = false;
+    freeSlots.push_back(slot);
+    count--;
+
+    if(entry != slot)
+    {
+        return;
+    }
+
+    //the new entry point is the node with the highest layer
+    entry = -1;
+    maxLevel = -1;
+    for(uint i = 0; i < nodes.size(); ++i)
+    {
+        if(nodes.at(i).used && nodes.at(i).level > maxLevel)
+        {
+            entry = i;
+            maxLevel = nodes.at(i).level;
+        }
+    }
+}
+
+void
+HnswIndex::search(const Descriptor& q, const uint& k, std::vector<Neighbor>& results)
+{
+    results.clear();
+    if(entry == -1)
+    {
+        return;
+    }
+
+    int ep = entry;
+    for(int l = maxLevel; l > 0; --l)
+    {
+        ep = greedy(q, ep, l);
+    }
+
+    search_layer(q, ep, (efSearch > k) ? efSearch : k, 0, found);
+    for(uint i = 0; i < k && i < found.size(); ++i)
+    {
+        results.push_back(Neighbor(found.at(i).first, nodes.at(found.at(i).second).id));
+    }
+}
+
+int
+HnswIndex::greedy(const Descriptor& q, int ep, const int& level) const
+{
+    float best = distance(q, nodes.at(ep).d);
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+        for(const auto& n : nodes.at(ep).links.at(level))
+        {
+            const float& dist = distance(q, nodes.at(n).d);
+            if(dist < best)
+            {
+                best = dist;
+                ep = n;
+                changed = true;
+            }
+        }
+    }
+    return ep;
+}
+
+void
+HnswIndex::search_layer(const Descriptor& q, const int& ep, const uint& ef, const int& level, std::vector<Neighbor>& found)
+{
+    if(visited.size() < nodes.size())
+    {
+        visited.resize(nodes.size(), 0);
+    }
+    if(++visit == 0)
+    {
+        std::fill(visited.begin(), visited.end(), 0);
+        visit = 1;
+    }
+
+    //candidates: min-heap to expand, found: max-heap of the best ef nodes
+    const auto& closer = [](const Neighbor& a, const Neighbor& b) { return a.first > b.first; };
+    candidates.clear();
+    found.clear();
+
+    const Neighbor start(distance(q, nodes.at(ep).d), ep);
+    visited.at(ep) = visit;
+    candidates.push_back(start);
+    found.push_back(start);
+
+    while(candidates.size() > 0)
+    {
+        std::pop_heap(candidates.begin(), candidates.end(), closer);
+        const Neighbor c = candidates.back();
+        candidates.pop_back();
+
+        if(c.first > found.front().first && found.size() >= ef)
+        {
+            break;
+        }
+
+        for(const auto& n : nodes.at(c.second).links.at(level))
+        {
+            if(visited.at(n) == visit)
+            {
+                continue;
+            }
+            visited.at(n) = visit;
+
+            const float& dist = distance(q, nodes.at(n).d);
+            if(found.size() < ef || dist < found.front().first)
+            {
+                candidates.push_back(Neighbor(dist, n));
+                std::push_heap(candidates.begin(), candidates.end(), closer);
+                found.push_back(Neighbor(dist, n));
+                std::push_heap(found.begin(), found.end());
+                if(found.size() > ef)
+                {
+                    std::pop_heap(found.begin(), found.end());
+                    found.pop_back();
+                }
+            }
+        }
+    }
+
+    std::sort_heap(found.begin(), found.end());
+}
+
+void
+HnswIndex::select_neighbors(std::vector<Neighbor>& list, const uint& n)
+{
+    kept.clear();
+    pruned.clear();
+    for(const auto& c : list)
+    {
+        if(kept.size() == n)
+        {
+            break;
+        }
+
+        //a candidate closer to a selected neighbour than to the node is reached through it
+        bool good = true;
+        for(const auto& k : kept)
+        {
+            if(distance(nodes.at(c.second).d, nodes.at(k.second).d) < c.first)
+            {
+                good = false;
+                break;
+            }
+        }
+
+        if(good)
+        {
+            kept.push_back(c);
+        }
+        else
+        {
+            pruned.push_back(c);
+        }
+    }
+
+    for(uint i = 0; i < pruned.size() && kept.size() < n; ++i)
+    {
+        kept.push_back(pruned.at(i));
+    }
+    list.assign(kept.begin(), kept.end());
+}
+
+void
+HnswIndex::shrink(const int& slot, const int& level)
+{
+    auto& links = nodes.at(slot).links.at(level);
+    neighbors.clear();
+    for(const auto& n : links)
+    {
+        neighbors.push_back(Neighbor(distance(nodes.at(slot).d, nodes.at(n).d), n));
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    select_neighbors(neighbors, maxLinks(level));
+
+    dropped.assign(links.begin(), links.end());
+    for(const auto& n : dropped)
+    {
+        const bool& keep = std::find_if(neighbors.begin(), neighbors.end(),
+                                        [&n](const Neighbor& k) { return k.second == n; }) != neighbors.end();
+        if(!keep)
+        {
+            disconnect(slot, n, level);
+        }
+    }
+}
+
+void
+HnswIndex::connect(const int& from, const int& to, const int& level)
+{
+    auto& links = nodes.at(from).links.at(level);
+    if(std::find(links.begin(), links.end(), to) != links.end())
+    {
+        return;
+    }
+    links.push_back(to);
+    nodes.at(to).inbound.at(level).push_back(from);
+}
+
+void
+HnswIndex::disconnect(const int& from, const int& to, const int& level)
+{
+    auto& links = nodes.at(from).links.at(level);
+    const auto& l = std::find(links.begin(), links.end(), to);
+    if(l != links.end())
+    {
+        *l = links.back();
+        links.pop_back();
+    }
+
+    auto& inbound = nodes.at(to).inbound.at(level);
+    const auto& i = std::find(inbound.begin(), inbound.end(), from);
+    if(i != inbound.end())
+    {
+        *i = inbound.back();
+        inbound.pop_back();
+    }
+}
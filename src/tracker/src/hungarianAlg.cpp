@@ -6,7 +6,7 @@ track_t
 AssignmentProblemSolver::Solve(const distMatrix_t& distMatrixIn, const size_t& nOfRows,
 	const size_t& nOfColumns, std::vector<int>& assignment, const TMethod& Method)
 {
-    assignment.resize(nOfRows, -1);
+    assignment.assign(nOfRows, -1);
 
     track_t cost = 0;
 
@@ -39,9 +39,9 @@ AssignmentProblemSolver::assignmentoptimal(assignments_t& assignment, track_t& c
 
     // Total elements number
     const size_t& nOfElements = nOfRows * nOfColumns;
-    // Memory allocation
+    // Memory allocation: the buffers of the solver are reused among the calls
     
-    distMatrix_t distMatrix(nOfElements);
+    distMatrix.resize(nOfElements);
     // Pointer to last element
     track_t* distMatrixEnd = distMatrix.data() + nOfElements;
 
@@ -54,11 +54,11 @@ AssignmentProblemSolver::assignmentoptimal(assignments_t& assignment, track_t& c
     }
 
     // Memory allocation
-    BoolVec coveredColumns(nOfColumns, 0);
-    BoolVec coveredRows(nOfRows, 0);
-    BoolVec starMatrix(nOfElements, 0);
-    BoolVec primeMatrix(nOfElements, 0);
-    BoolVec newStarMatrix(nOfElements, 0); /* used in step4 */
+    coveredColumns.assign(nOfColumns, 0);
+    coveredRows.assign(nOfRows, 0);
+    starMatrix.assign(nOfElements, 0);
+    primeMatrix.assign(nOfElements, 0);
+    newStarMatrix.assign(nOfElements, 0); /* used in step4 */
     
     /* preliminary steps */
     if (nOfRows <= nOfColumns)
@@ -16,56 +16,35 @@ Hyphothesis::instance()
 }
 
 void 
-Hyphothesis::new_hyphothesis(const cv::Mat& dummmy_assignments, Tracks& tracks, const Detections& detections, const uint& w, const uint& h, 
+Hyphothesis::new_hyphothesis(const assignments_t& assignments, Tracks& tracks, const Detections& detections, const uint& w, const uint& h, 
 				     const uint& new_hyp_dummy_costs, Detections& prev_unassigned, const KalmanParam& param, const int cameraNum)
 {
-  cv::Mat assignments = dummmy_assignments.clone();
-  
-  assignments.setTo(1, assignments == 255);
+  const uint& dSize = detections.size();
   
   //Unassigned observations
-  cv::Mat ass_sum;
-  cv::reduce(assignments, ass_sum, 0, CV_REDUCE_SUM, CV_32S);
-   
-  cv::Mat tmp_unassigned = ass_sum == 0;
-  cv::Mat unassigned;
-  cv::findNonZero(tmp_unassigned, unassigned);
+  assigned.assign(dSize, 0);
+  for(const auto& idx : assignments)
+  {
+      if(idx != -1)
+      {
+          assigned.at(idx) = 1;
+      }
+  }
   
-  uint nunassigned = unassigned.total();
+  unassigned.clear();
+  for(uint i = 0; i < dSize; ++i)
+  {
+      if(!assigned.at(i))
+      {
+          unassigned.push_back(i);
+      }
+  }
   
-  cv::Mat new_hyp = cv::Mat(cv::Size(prev_unassigned.size(), nunassigned), CV_32FC1, cv::Scalar(0));
-  distMatrix_t cost(prev_unassigned.size() * nunassigned);
-  assignments_t new_assignments;
+  const uint& rows = unassigned.size();
+  const uint& cols = prev_unassigned.size();
   
-  if(cost.size() != 0)
+  if(rows * cols != 0)
   {   
-        float amp;
-        cv::Point2f elem;
-        const uint& nHrows = (uint) new_hyp.rows;
-        const uint& nHcols = (uint) new_hyp.cols;
-        //Compute the cost between the current detections and the previous
-        for(uint i = 0; i < nHrows; ++i)
-        {
-            const uint idx = unassigned.at<cv::Point>(i).x;
-            elem = (cv::Point2f)detections.at(idx)();
-            for(uint j = 0; j < nHcols; ++j)
-            {
-                // How "good" are tracks that started at one of the previously
-                // unassigned observations? The cost amplification is high in 
-                // the middle, but low on the sides. 
-                amp = beta_likelihood(prev_unassigned.at(j)(), 1.5, 1.5, w, h);
-        
-                elem = prev_unassigned.at(j)() - elem;
-        
-                new_hyp.at<float>(i, j) = amp * sqrt(elem.x * elem.x + elem.y * elem.y);
-                cost.at(i + j * new_hyp.rows ) = amp * new_hyp.at<float>(i, j);
-            }
-        }
-    
-    
-        const uint& rows = new_hyp.rows;
-        const uint& cols = new_hyp.cols;
-
         uint n_w, n_h;
         if(rows < cols)
         {
@@ -82,84 +61,54 @@ Hyphothesis::new_hyphothesis(const cv::Mat& dummmy_assignments, Tracks& tracks,
             n_w = cols; 
             n_h = rows;
         }
-    
-    
-        cv::Mat lap_costs = cv::Mat(cv::Size(n_w, n_h), CV_32SC1, cv::Scalar(new_hyp_dummy_costs));
-        new_hyp.copyTo(lap_costs(cv::Rect(0, 0, cols, rows)));
         
-        
-        std::vector<int> colsol(n_w);
-        std::vector<int> rowsol(n_w);
-        
-        std::vector<int> u(n_w), v(n_w);
-        
-        std::vector< std::vector<int> > lap_costs_matrix(n_h, std::vector<int>(n_w));
-        for(uint i = 0; i < n_h; ++i)
+        lap_costs.resize(n_h);
+        for(auto& row : lap_costs)
         {
-            for(uint j = 0; j < n_w; ++j)
-            {
-                lap_costs_matrix[i][j] = lap_costs.at<int>(i, j);
-            }
+            row.assign(n_w, new_hyp_dummy_costs);
         }
-    
-        LapCost::instance()->lap(n_w, lap_costs_matrix, rowsol, colsol, u, v);
-        
-        new_hyp = cv::Mat(cv::Size(n_w, n_h), CV_32SC1, cv::Scalar(0));
-        
         
-        for(uint i = 0; i < n_w; ++i)
-        {
-            new_hyp.at<int>((i*n_w)+rowsol.at(i)) = 1;
-        }
-  
-    
-        cv::Mat new_assigments = new_hyp(cv::Rect(0, 0, cols, rows));
-        new_assigments.convertTo(new_assigments, CV_32S);
-
-        if(new_assigments.total() > 1)
+        //Compute the cost between the current detections and the previous
+        for(uint i = 0; i < rows; ++i)
         {
-            ass_sum = cv::Mat(cv::Size(1, rows), new_assigments.type(), cv::Scalar(0));
-            const uint& nAcols = new_assigments.cols;
-            for(uint i = 0; i < nAcols; ++i)
+            const cv::Point2f& elem = detections.at(unassigned.at(i))();
+            for(uint j = 0; j < cols; ++j)
             {
-                ass_sum += new_assigments(cv::Rect(i, 0, 1, rows));
+                // How "good" are tracks that started at one of the previously
+                // unassigned observations? The cost amplification is high in 
+                // the middle, but low on the sides. 
+                const float& amp = beta_likelihood(prev_unassigned.at(j)(), 1.5, 1.5, w, h);
+        
+                const cv::Point2f& diff = prev_unassigned.at(j)() - elem;
+        
+                lap_costs[i][j] = cvRound(amp * sqrt(diff.x * diff.x + diff.y * diff.y));
             }
         }
-        else
-        {
-            ass_sum = new_assigments.clone();
-        }
-    
     
-        if(ass_sum.cols > 1)
-        {
-            std::cout << "ass_sum.cols > 1 " << std::endl;
-            exit(-1);
-        }
+        rowsol.resize(n_w);
+        colsol.resize(n_w);
+        u.resize(n_w);
+        v.resize(n_w);
     
-        tmp_unassigned = ass_sum == 1;
-        cv::Mat new_unassigned;
-        cv::findNonZero(tmp_unassigned, new_unassigned);
+        LapCost::instance()->lap(n_w, lap_costs, rowsol, colsol, u, v);
         
-        //create new tracks if needed
-        if(new_unassigned.total() != 0)
+        //create new tracks if needed: the observation is matched to a previous one and not to a dummy
+        for(uint i = 0; i < rows; ++i)
         {
-            const uint& nUtotal = new_unassigned.total();
-            for(uint i = 0; i < nUtotal; ++i)
+            const int& idx = unassigned.at(i);
+            if(rowsol.at(i) < int(cols))
             {
-                const int idx = unassigned.at<cv::Point>(new_unassigned.at<cv::Point>(i).y).x;
-                Track_ptr tr(new Track(detections.at(idx).x(), detections.at(idx).y(), param, detections.at(idx).hist(), cameraNum));
+                Track_ptr tr = TrackPool::instance()->acquire(detections.at(idx).x(), detections.at(idx).y(), param, detections.at(idx).hist(), cameraNum);
                 tracks.push_back(tr);
+                assigned.at(idx) = 1;
             }
         }
     }
   
     prev_unassigned.clear();
-    const uint& dSize = detections.size();
     for(uint i = 0; i < dSize; ++i)
     {
-        if(ass_sum.at<int>(i) == 0 || 
-            (new_assignments.size() > 0 && std::find(new_assignments.begin(), new_assignments.end(), i) == new_assignments.end()))
+        if(!assigned.at(i))
         {
             prev_unassigned.push_back(detections.at(i));
         }
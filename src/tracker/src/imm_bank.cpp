@@ -0,0 +1,236 @@
+#include "imm_bank.h"
+
+using namespace mctracker::tracker;
+
+ImmBank
+::ImmBank(const float& _stay, const float& _turnRate, const float& _frameDt)
+    : stay(_stay), turnRate(_turnRate), frameDt(_frameDt), d_t(-1)
+{
+    nModels = (turnRate > 0) ? max_models : 2;
+
+    for(uint i = 0; i < nModels; ++i)
+    {
+        for(uint j = 0; j < nModels; ++j)
+        {
+            transition[i][j] = (i == j) ? stay : (1.f - stay) / (nModels - 1);
+        }
+    }
+}
+
+void
+ImmBank::sync(const Tracks& tracks)
+{
+    const uint& tSize = tracks.size();
+
+    bool changed = (order.size() != tSize);
+    for(uint i = 0; i < tSize && !changed; ++i)
+    {
+        changed = (order.at(i) != tracks.at(i)->serial());
+    }
+    if(!changed)
+    {
+        return;
+    }
+
+    index.clear();
+    for(uint i = 0; i < order.size(); ++i)
+    {
+        index[order.at(i)] = i;
+    }
+
+    next.resize(tSize);
+    for(uint i = 0; i < tSize; ++i)
+    {
+        const auto& found = index.find(tracks.at(i)->serial());
+        if(found != index.end())
+        {
+            next.at(i) = states.at(found->second);
+            continue;
+        }
+
+        //new or restored track: all the models start from its filter with the same probability
+        auto& s = next.at(i);
+        tracks.at(i)->kf->getPosterior(s.x[0], s.P[0]);
+        for(uint m = 1; m < nModels; ++m)
+        {
+            s.x[m] = s.x[0];
+            s.P[m] = s.P[0];
+        }
+        std::fill(s.mu, s.mu + nModels, 1.f / nModels);
+        s.combined = s.x[0];
+    }
+    std::swap(states, next);
+
+    order.resize(tSize);
+    for(uint i = 0; i < tSize; ++i)
+    {
+        order.at(i) = tracks.at(i)->serial();
+    }
+}
+
+void
+ImmBank::update_models(const float& dt, const cv::Matx44f& Fcv, const cv::Matx44f& Qcv)
+{
+    d_t = dt;
+
+    //constant position: the velocity is reset
+    F[0] = cv::Matx44f::zeros();
+    F[0](0, 0) = F[0](1, 1) = 1;
+    Q[0] = Qcv;
+
+    F[1] = Fcv;
+    Q[1] = Qcv;
+
+    if(nModels == max_models)
+    {
+        //coordinated turns with a known rate, one for each direction
+        const float& omega = turnRate / frameDt;
+        for(uint m = 2; m < max_models; ++m)
+        {
+            const float& w = (m == 2) ? omega : -omega;
+            const float& s = std::sin(w * dt);
+            const float& c = std::cos(w * dt);
+            F[m] = cv::Matx44f(1, 0, s / w, -(1 - c) / w,
+                               0, 1, (1 - c) / w, s / w,
+                               0, 0, c, -s,
+                               0, 0, s, c);
+            Q[m] = Qcv;
+        }
+    }
+}
+
+void
+ImmBank::predict(const Tracks& tracks)
+{
+    sync(tracks);
+    if(tracks.size() == 0)
+    {
+        return;
+    }
+
+    //all the tracks are predicted with the same dt
+    const auto& kf = tracks.at(0)->kf;
+    if(kf->getDt() != d_t)
+    {
+        update_models(kf->getDt(), kf->F(), kf->Q());
+    }
+
+    cv::Matx41f x0[max_models];
+    cv::Matx44f P0[max_models];
+    float c[max_models];
+    cv::Matx41f x, posterior;
+    cv::Matx44f P, covariance;
+    for(uint i = 0; i < tracks.size(); ++i)
+    {
+        auto& s = states.at(i);
+
+        //a correction applied to the filter outside the bank (late detections, MHT, JPDA) moves all the models
+        tracks.at(i)->kf->getPosterior(posterior, covariance);
+        const cv::Matx41f& delta = posterior - s.combined;
+        if(delta.dot(delta) > 0)
+        {
+            for(uint m = 0; m < nModels; ++m)
+            {
+                s.x[m] += delta;
+            }
+        }
+
+        //MIXING
+        for(uint j = 0; j < nModels; ++j)
+        {
+            c[j] = 0;
+            for(uint m = 0; m < nModels; ++m)
+            {
+                c[j] += transition[m][j] * s.mu[m];
+            }
+
+            x0[j] = cv::Matx41f::zeros();
+            for(uint m = 0; m < nModels; ++m)
+            {
+                x0[j] += (transition[m][j] * s.mu[m] / c[j]) * s.x[m];
+            }
+
+            P0[j] = cv::Matx44f::zeros();
+            for(uint m = 0; m < nModels; ++m)
+            {
+                const cv::Matx41f& d = s.x[m] - x0[j];
+                P0[j] += (transition[m][j] * s.mu[m] / c[j]) * (s.P[m] + d * d.t());
+            }
+        }
+
+        //PREDICTION
+        for(uint j = 0; j < nModels; ++j)
+        {
+            s.x[j] = F[j] * x0[j];
+            s.P[j] = F[j] * P0[j] * F[j].t() + Q[j];
+            s.mu[j] = c[j];
+        }
+
+        combine(s, x, P);
+        s.combined = x;
+        tracks.at(i)->predict(x, P);
+    }
+}
+
+void
+ImmBank::correct(const Tracks& tracks, const assignments_t& assignment, const Detections& detections)
+{
+    cv::Matx41f x;
+    cv::Matx44f P;
+    double likelihood[max_models];
+    for(uint i = 0; i < order.size() && i < tracks.size() && i < assignment.size(); ++i)
+    {
+        //the missed tracks keep the predicted models and probabilities
+        const auto& j = assignment.at(i);
+        if(tracks.at(i)->serial() != order.at(i) || j == -1)
+        {
+            continue;
+        }
+
+        auto& s = states.at(i);
+        const cv::Matx22f& R = tracks.at(i)->kf->R();
+        double total = 0;
+        for(uint m = 0; m < nModels; ++m)
+        {
+            const cv::Matx22f& S = s.P[m].get_minor<2, 2>(0, 0) + R;
+            const cv::Matx22f& Si = S.inv();
+            const cv::Matx21f v(detections.at(j).x() - s.x[m](0), detections.at(j).y() - s.x[m](1));
+            const cv::Matx<float, 4, 2>& K = s.P[m].get_minor<4, 2>(0, 0) * Si;
+            s.x[m] += K * v;
+            s.P[m] -= K * s.P[m].get_minor<2, 4>(0, 0);
+
+            likelihood[m] = std::exp(-0.5 * v.dot(Si * v)) / (2. * CV_PI * std::sqrt(cv::determinant(S)));
+            total += s.mu[m] * likelihood[m];
+        }
+
+        //a detection far from all the models does not change their probabilities
+        if(total > 0)
+        {
+            for(uint m = 0; m < nModels; ++m)
+            {
+                s.mu[m] = float(s.mu[m] * likelihood[m] / total);
+            }
+        }
+
+        combine(s, x, P);
+        s.combined = x;
+        tracks.at(i)->kf->setPosterior(x, P);
+    }
+}
+
+void
+ImmBank::combine(const State& s, cv::Matx41f& x, cv::Matx44f& P) const
+{
+    x = cv::Matx41f::zeros();
+    for(uint m = 0; m < nModels; ++m)
+    {
+        x += s.mu[m] * s.x[m];
+    }
+
+    P = cv::Matx44f::zeros();
+    for(uint m = 0; m < nModels; ++m)
+    {
+        const cv::Matx41f& d = s.x[m] - x;
+        P += s.mu[m] * (s.P[m] + d * d.t());
+    }
+}
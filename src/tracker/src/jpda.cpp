@@ -0,0 +1,266 @@
+#include "jpda.h"
+
+using namespace mctracker::tracker;
+
+Jpda
+::Jpda(const float& _pd, const float& _clutter, const uint& _maxEvents, const float& _gate)
+    : pd(_pd), clutter(_clutter), maxEvents(_maxEvents), gate(_gate), total(0)
+{
+    ;
+}
+
+void
+Jpda::associate(const Tracks& tracks, const Detections& detections, assignments_t& assignment)
+{
+    const uint& tSize = tracks.size();
+    const uint& dSize = detections.size();
+
+    assignment.assign(tSize, -1);
+    order.resize(tSize);
+    x.resize(tSize);
+    P.resize(tSize);
+    missed.assign(tSize, 1.);
+    first.assign(tSize + 1, 0);
+    pairs.clear();
+
+    //the likelihood of a detection is compared with the density of the false detections
+    const double& ratio = pd / ((1. - pd) * clutter);
+
+    //GATING: the same mahalanobis distances of the single assignment
+    for(uint i = 0; i < tSize; ++i)
+    {
+        const auto& track = tracks.at(i);
+        order.at(i) = track.get();
+        track->kf->getPosterior(x.at(i), P.at(i));
+        first.at(i) = pairs.size();
+
+        if(dSize == 0) continue;
+
+        const cv::Mat& mu = track->getPrediction();
+        const cv::Matx22f& icovar = track->invS();
+        const double& norm = std::sqrt(cv::determinant(icovar)) / (2. * CV_PI);
+
+        for(uint j = 0; j < dSize; ++j)
+        {
+            const cv::Vec2f d(detections.at(j).x() - mu.at<float>(0), detections.at(j).y() - mu.at<float>(1));
+            const float& dist = std::sqrt(d.dot(icovar * d));
+            if(dist < gate)
+            {
+                Pair p;
+                p.track = i;
+                p.detection = j;
+                p.ratio = ratio * norm * std::exp(-0.5 * dist * dist);
+                p.beta = 0;
+                p.v = d;
+                pairs.push_back(p);
+            }
+        }
+    }
+    first.at(tSize) = pairs.size();
+
+    if(pairs.size() == 0) return;
+
+    //CLUSTERS: two tracks are in the same cluster if they share a gated detection
+    parent.resize(tSize);
+    std::iota(parent.begin(), parent.end(), 0);
+    owner.assign(dSize, -1);
+    for(const auto& p : pairs)
+    {
+        auto& o = owner.at(p.detection);
+        if(o == -1)
+        {
+            o = p.track;
+        }
+        else
+        {
+            parent.at(find(p.track)) = find(o);
+        }
+    }
+
+    roots.resize(tSize);
+    for(uint i = 0; i < tSize; ++i)
+    {
+        roots.at(i) = find(i);
+    }
+    members.resize(tSize);
+    std::iota(members.begin(), members.end(), 0);
+    std::stable_sort(members.begin(), members.end(), [this](const int& a, const int& b) { return roots.at(a) < roots.at(b); });
+
+    used.assign(dSize, 0);
+    detectionSums.assign(dSize, 0.);
+    chosen.resize(tSize);
+    for(uint begin = 0; begin < tSize; )
+    {
+        uint end = begin + 1;
+        while(end < tSize && roots.at(members.at(end)) == roots.at(members.at(begin)))
+        {
+            end++;
+        }
+
+        //the clusters with few joint events are exact, the others are approximated
+        double events = 1;
+        for(uint m = begin; m < end && events <= maxEvents; ++m)
+        {
+            const auto& i = members.at(m);
+            events *= first.at(i + 1) - first.at(i) + 1;
+        }
+
+        if(events > maxEvents)
+        {
+            approximate(begin, end);
+        }
+        else if(events > 1)
+        {
+            exact(begin, end);
+        }
+        begin = end;
+    }
+
+    //the most probable pairs drive the life cycle of the tracks
+    ranking.resize(pairs.size());
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::sort(ranking.begin(), ranking.end(), [this](const int& a, const int& b) { return pairs.at(a).beta > pairs.at(b).beta; });
+    for(const auto& r : ranking)
+    {
+        const auto& p = pairs.at(r);
+        if(assignment.at(p.track) == -1 && !used.at(p.detection) && p.beta > missed.at(p.track))
+        {
+            assignment.at(p.track) = p.detection;
+            used.at(p.detection) = 1;
+        }
+    }
+}
+
+void
+Jpda::commit(const Tracks& tracks)
+{
+    for(uint i = 0; i < order.size() && i < tracks.size(); ++i)
+    {
+        if(tracks.at(i).get() != order.at(i) || first.at(i) == first.at(i + 1))
+        {
+            continue;
+        }
+
+        const cv::Matx44f& Pp = P.at(i);
+        const cv::Matx22f& S = Pp.get_minor<2, 2>(0, 0) + tracks.at(i)->kf->R();
+        const cv::Matx<float, 4, 2>& K = Pp.get_minor<4, 2>(0, 0) * S.inv();
+
+        //combined innovation and its spread
+        cv::Matx21f v = cv::Matx21f::zeros();
+        cv::Matx22f spread = cv::Matx22f::zeros();
+        for(uint k = first.at(i); k < first.at(i + 1); ++k)
+        {
+            const auto& p = pairs.at(k);
+            const cv::Matx21f vk(p.v[0], p.v[1]);
+            v += float(p.beta) * vk;
+            spread += float(p.beta) * (vk * vk.t());
+        }
+        spread -= v * v.t();
+
+        const float& beta0 = missed.at(i);
+        const cv::Matx44f& Pc = Pp - K * Pp.get_minor<2, 4>(0, 0);
+        const cv::Matx41f& xu = x.at(i) + K * v;
+        const cv::Matx44f& Pu = beta0 * Pp + (1.f - beta0) * Pc + K * spread * K.t();
+        tracks.at(i)->kf->setPosterior(xu, Pu);
+    }
+}
+
+int
+Jpda::find(int i)
+{
+    while(parent.at(i) != i)
+    {
+        parent.at(i) = parent.at(parent.at(i));
+        i = parent.at(i);
+    }
+    return i;
+}
+
+void
+Jpda::exact(const uint& begin, const uint& end)
+{
+    total = 0;
+    enumerate(begin, begin, end, 1.);
+
+    for(uint m = begin; m < end; ++m)
+    {
+        const auto& i = members.at(m);
+        double sum = 0;
+        for(uint k = first.at(i); k < first.at(i + 1); ++k)
+        {
+            pairs.at(k).beta /= total;
+            sum += pairs.at(k).beta;
+        }
+        missed.at(i) = (sum < 1.) ? 1. - sum : 0.;
+    }
+}
+
+void
+Jpda::enumerate(const uint& begin, const uint& depth, const uint& end, const double& weight)
+{
+    if(depth == end)
+    {
+        //a complete joint event: its weight is added to all its pairs
+        total += weight;
+        for(uint m = begin; m < end; ++m)
+        {
+            if(chosen.at(m) != -1)
+            {
+                pairs.at(chosen.at(m)).beta += weight;
+            }
+        }
+        return;
+    }
+
+    const auto& i = members.at(depth);
+
+    //the track is not detected
+    chosen.at(depth) = -1;
+    enumerate(begin, depth + 1, end, weight);
+
+    //the track originates one of its free gated detections
+    for(uint k = first.at(i); k < first.at(i + 1); ++k)
+    {
+        const auto& j = pairs.at(k).detection;
+        if(!used.at(j))
+        {
+            used.at(j) = 1;
+            chosen.at(depth) = k;
+            enumerate(begin, depth + 1, end, weight * pairs.at(k).ratio);
+            used.at(j) = 0;
+        }
+    }
+}
+
+void
+Jpda::approximate(const uint& begin, const uint& end)
+{
+    for(uint m = begin; m < end; ++m)
+    {
+        const auto& i = members.at(m);
+        for(uint k = first.at(i); k < first.at(i + 1); ++k)
+        {
+            detectionSums.at(pairs.at(k).detection) += pairs.at(k).ratio;
+        }
+    }
+
+    //beta = ratio / (track sum + detection sum - ratio + miss weight)
+    for(uint m = begin; m < end; ++m)
+    {
+        const auto& i = members.at(m);
+        double trackSum = 0;
+        for(uint k = first.at(i); k < first.at(i + 1); ++k)
+        {
+            trackSum += pairs.at(k).ratio;
+        }
+
+        double sum = 0;
+        for(uint k = first.at(i); k < first.at(i + 1); ++k)
+        {
+            auto& p = pairs.at(k);
+            p.beta = p.ratio / (trackSum + detectionSums.at(p.detection) - p.ratio + 1.);
+            sum += p.beta;
+        }
+        missed.at(i) = (sum < 1.) ? 1. - sum : 0.;
+    }
+}
@@ -6,14 +6,22 @@ using namespace mctracker::tracker;
 KalmanFilter
 ::KalmanFilter(const float &_x, const float &_y, const float &dt)
 {
-    
-    measurement = cv::Mat_<float>(2, 1, CV_32F);
-    measurement.setTo(cv::Scalar(0));
+    init(_x, _y, dt);
+}
 
-    KF = cv::KalmanFilter(4, 2, 0);
-    state = cv::Mat_<float>(4, 1);
-    processNoise = cv::Mat(4, 1, CV_32F);
-    measurement = cv::Mat_<float>(2, 1);
+void 
+KalmanFilter::init(const float &_x, const float &_y, const float &dt)
+{
+    //the matrices are allocated only the first time, a recycled filter is reset in place
+    if(KF.statePost.rows != 4)
+    {
+        KF = cv::KalmanFilter(4, 2, 0);
+        state = cv::Mat_<float>(4, 1);
+        processNoise = cv::Mat(4, 1, CV_32F);
+        measurement = cv::Mat_<float>(2, 1);
+        prediction = cv::Mat(cv::Size(4, 1), CV_32FC1);
+    }
+    
     measurement.setTo(cv::Scalar(0));
 
     KF.statePre.at<float>(0, 0) = _x;
@@ -26,24 +34,18 @@ KalmanFilter
     KF.statePost.at<float>(2) = 0;
     KF.statePost.at<float>(3) = 0;
 
-    KF.transitionMatrix = (cv::Mat_<float>(4, 4) << 1,0,dt,0,
-                                                     0,1,0,dt,
-                                                     0,0,1,0,
-                                                     0,0,0,1);
+    cv::setIdentity(KF.transitionMatrix);
+    KF.transitionMatrix.at<float>(2) = dt;
+    KF.transitionMatrix.at<float>(7) = dt;
 
     cv::setIdentity(KF.measurementMatrix);
     
-    KF.processNoiseCov=(cv::Mat_<float>(4, 4) <<
-            pow(dt,4.0)/4.0,    0,  pow(dt,3.0)/2.0,    0,
-            0,  pow(dt,4.0)/4.0,   0,  pow(dt,3.0)/2.0,
-            pow(dt,3.0)/2.0,    0,  pow(dt,2.0),    0,
-            0,  pow(dt,3.0)/2.0,  0,    pow(dt,2.0));
-
-    KF.processNoiseCov*=.3;
+    d_t = dt;
+    process_noise(dt, KF.processNoiseCov);
     cv::setIdentity(KF.measurementNoiseCov, cv::Scalar::all(1e-0));
     cv::setIdentity(KF.errorCovPost, cv::Scalar::all(0.5));
+    KF.errorCovPre.setTo(cv::Scalar(0));
     
-    prediction = cv::Mat(cv::Size(4, 1), CV_32FC1);
     prediction.at<float>(0) = _x;
     prediction.at<float>(1) = _y;
     prediction.at<float>(2) = 0;
@@ -68,3 +70,87 @@ KalmanFilter::correct(const int &_x, const int &_y)
     const auto& estimated = KF.correct(measurement);
     return estimated;
 }
+
+cv::Mat 
+KalmanFilter::correctLate(const float &_x, const float &_y, const float &lag)
+{
+    const cv::Mat& x = KF.statePost.clone();
+    const cv::Mat& P = KF.errorCovPost.clone();
+    const cv::Mat& H = KF.measurementMatrix;
+    
+    //backward transition from the current state to the acquisition time of the measurement
+    cv::Mat F = cv::Mat::eye(4, 4, CV_32F);
+    F.at<float>(0, 2) = -lag;
+    F.at<float>(1, 3) = -lag;
+    
+    //the process noise over the lag makes the retrodicted state less reliable
+    const cv::Mat& retrodicted = F * x;
+    cv::Mat Q;
+    process_noise(lag, Q);
+    const cv::Mat& Pr = F * P * F.t() + Q;
+    const cv::Mat& S = H * Pr * H.t() + KF.measurementNoiseCov;
+    
+    //gain computed from the cross covariance between the current state and the late measurement
+    const cv::Mat& W = P * F.t() * H.t() * S.inv();
+    
+    measurement(0) = _x;
+    measurement(1) = _y;
+    const cv::Mat& innovation = cv::Mat(measurement) - H * retrodicted;
+    
+    KF.statePost = x + W * innovation;
+    KF.errorCovPost = P - W * S * W.t();
+    return KF.statePost;
+}
+
+void 
+KalmanFilter::retrodict(const float &lag, cv::Point2f& z, cv::Matx22f& iS) const
+{
+    cv::Matx41f x;
+    cv::Matx44f P;
+    getPosterior(x, P);
+    
+    cv::Matx44f F = cv::Matx44f::eye();
+    F(0, 2) = -lag;
+    F(1, 3) = -lag;
+    
+    //the process noise is written into the fixed-size matrix
+    cv::Matx44f Q;
+    cv::Mat q(4, 4, CV_32F, Q.val);
+    process_noise(lag, q);
+    
+    const cv::Matx44f& Pr = F * P * F.t() + Q;
+    const cv::Matx22f& r = R();
+    z = cv::Point2f(x(0) - lag * x(2), x(1) - lag * x(3));
+    iS = cv::Matx22f(Pr(0, 0) + r(0, 0), Pr(0, 1) + r(0, 1),
+                     Pr(1, 0) + r(1, 0), Pr(1, 1) + r(1, 1)).inv();
+}
+
+const void 
+KalmanFilter::setDt(const float& dt)
+{
+    if(dt == d_t)
+    {
+        return;
+    }
+    
+    d_t = dt;
+    KF.transitionMatrix.at<float>(2) = dt;
+    KF.transitionMatrix.at<float>(7) = dt;
+    process_noise(dt, KF.processNoiseCov);
+}
+
+void 
+KalmanFilter::process_noise(const float& dt, cv::Mat& Q) const
+{
+    const float& dt2 = dt * dt;
+    const float& dt3 = dt2 * dt;
+    const float& dt4 = dt3 * dt;
+    
+    //written in place: no allocation when the matrix already exists
+    Q.create(4, 4, CV_32F);
+    Q.setTo(cv::Scalar(0));
+    Q.at<float>(0, 0) = Q.at<float>(1, 1) = noise_scale * dt4 / 4.;
+    Q.at<float>(0, 2) = Q.at<float>(2, 0) = noise_scale * dt3 / 2.;
+    Q.at<float>(1, 3) = Q.at<float>(3, 1) = noise_scale * dt3 / 2.;
+    Q.at<float>(2, 2) = Q.at<float>(3, 3) = noise_scale * dt2;
+}
@@ -0,0 +1,174 @@
+#include "mot_metrics.h"
+
+using namespace mctracker::tracker;
+
+MotMetrics
+::MotMetrics(const float& _threshold)
+    : threshold(_threshold), frames(0), gtTotal(0), hypTotal(0), matches(0), misses(0), falsePositives(0),
+      idSwitches(0), distances(0), idtp(0)
+{
+    ;
+}
+
+void
+MotMetrics::update(const std::vector<TrajectoryRecord>& gt, const std::vector<TrajectoryRecord>& hyp)
+{
+    const uint& gSize = gt.size();
+    const uint& hSize = hyp.size();
+
+    frames++;
+    gtTotal += gSize;
+    hypTotal += hSize;
+
+    //pairs which can be matched for the identity metrics
+    for(const auto& g : gt)
+    {
+        for(const auto& h : hyp)
+        {
+            if(distance(g, h) < threshold)
+            {
+                overlaps[std::make_pair(g.label, h.label)]++;
+            }
+        }
+    }
+
+    //the correspondences of the previous frames are kept while they are valid
+    std::vector<int> gtMatch(gSize, -1);
+    std::vector<bool> hypUsed(hSize, false);
+    for(uint i = 0; i < gSize; ++i)
+    {
+        const auto& last = lastMatch.find(gt.at(i).label);
+        if(last == lastMatch.end())
+        {
+            continue;
+        }
+
+        for(uint j = 0; j < hSize; ++j)
+        {
+            if(!hypUsed.at(j) && hyp.at(j).label == last->second && distance(gt.at(i), hyp.at(j)) < threshold)
+            {
+                gtMatch.at(i) = j;
+                hypUsed.at(j) = true;
+                break;
+            }
+        }
+    }
+
+    //the other objects are matched with the munkres algorithm
+    std::vector<int> rows, cols;
+    for(uint i = 0; i < gSize; ++i)
+    {
+        if(gtMatch.at(i) == -1) rows.push_back(i);
+    }
+    for(uint j = 0; j < hSize; ++j)
+    {
+        if(!hypUsed.at(j)) cols.push_back(j);
+    }
+
+    if(rows.size() > 0 && cols.size() > 0)
+    {
+        const uint& rSize = rows.size();
+        distMatrix_t cost(rSize * cols.size());
+        for(uint r = 0; r < rSize; ++r)
+        {
+            for(uint c = 0; c < cols.size(); ++c)
+            {
+                const float& d = distance(gt.at(rows.at(r)), hyp.at(cols.at(c)));
+                cost.at(r + c * rSize) = (d < threshold) ? d : gated_cost;
+            }
+        }
+
+        assignments_t assignments;
+        solver.Solve(cost, rSize, cols.size(), assignments, AssignmentProblemSolver::optimal);
+        for(uint r = 0; r < assignments.size(); ++r)
+        {
+            const auto& c = assignments[r];
+            if(c != -1 && cost.at(r + c * rSize) < threshold)
+            {
+                gtMatch.at(rows.at(r)) = cols.at(c);
+                hypUsed.at(cols.at(c)) = true;
+            }
+        }
+    }
+
+    uint matched = 0;
+    for(uint i = 0; i < gSize; ++i)
+    {
+        if(gtMatch.at(i) == -1)
+        {
+            misses++;
+            continue;
+        }
+
+        const auto& g = gt.at(i);
+        const auto& h = hyp.at(gtMatch.at(i));
+        matched++;
+        distances += distance(g, h);
+
+        const auto& last = lastMatch.find(g.label);
+        if(last != lastMatch.end() && last->second != h.label)
+        {
+            idSwitches++;
+        }
+        lastMatch[g.label] = h.label;
+    }
+
+    matches += matched;
+    falsePositives += hSize - matched;
+}
+
+void
+MotMetrics::finalize()
+{
+    //global one to one assignment between ground truth and track ids maximizing the shared frames
+    std::map<int, int> gtIds, hypIds;
+    uint maxOverlap = 0;
+    for(const auto& overlap : overlaps)
+    {
+        gtIds.insert(std::make_pair(overlap.first.first, int(gtIds.size())));
+        hypIds.insert(std::make_pair(overlap.first.second, int(hypIds.size())));
+        maxOverlap = std::max(maxOverlap, overlap.second);
+    }
+
+    idtp = 0;
+    if(overlaps.size() == 0)
+    {
+        return;
+    }
+
+    const uint& rSize = gtIds.size();
+    distMatrix_t cost(rSize * hypIds.size(), float(maxOverlap));
+    for(const auto& overlap : overlaps)
+    {
+        const auto& r = gtIds.at(overlap.first.first);
+        const auto& c = hypIds.at(overlap.first.second);
+        cost.at(r + c * rSize) = float(maxOverlap - overlap.second);
+    }
+
+    assignments_t assignments;
+    solver.Solve(cost, rSize, hypIds.size(), assignments, AssignmentProblemSolver::optimal);
+    for(uint r = 0; r < assignments.size(); ++r)
+    {
+        const auto& c = assignments[r];
+        if(c != -1)
+        {
+            idtp += maxOverlap - cost.at(r + c * rSize);
+        }
+    }
+}
+
+void
+MotMetrics::toJson(std::ostream& out) const
+{
+    out << "  \"frames\": " << frames << "," << std::endl;
+    out << "  \"ground_truth\": " << gtTotal << "," << std::endl;
+    out << "  \"tracks\": " << hypTotal << "," << std::endl;
+    out << "  \"matches\": " << matches << "," << std::endl;
+    out << "  \"misses\": " << misses << "," << std::endl;
+    out << "  \"false_positives\": " << falsePositives << "," << std::endl;
+    out << "  \"id_switches\": " << idSwitches << "," << std::endl;
+    out << "  \"mota\": " << mota() << "," << std::endl;
+    out << "  \"motp\": " << motp() << "," << std::endl;
+    out << "  \"idf1\": " << idf1() << "," << std::endl;
+    out << "  \"threshold\": " << threshold;
+}
@@ -0,0 +1,545 @@
+#include "multi_hypothesis.h"
+
+using namespace mctracker::tracker;
+
+MultiHypothesis
+::MultiHypothesis(const uint& _k, const uint& _scan, const float& _missCost, const float& _gate)
+    : k(_k), scan(_scan), missCost(_missCost), gate(_gate), nodes(0), current(0)
+{
+    if(k < 1)
+    {
+        k = 1;
+    }
+    if(scan > max_scan)
+    {
+        scan = max_scan;
+    }
+
+    //the root hypothesis: no tracks and no decisions
+    Hypothesis root;
+    root.cost = 0;
+    std::fill(root.ancestors, root.ancestors + max_scan + 1, 0);
+    root.states = nullptr;
+    root.assignment = nullptr;
+    hypotheses.push_back(root);
+}
+
+void
+MultiHypothesis::sync(const Tracks& tracks)
+{
+    const uint& tSize = tracks.size();
+
+    bool changed = (order.size() != tSize);
+    for(uint i = 0; i < tSize && !changed; ++i)
+    {
+        changed = (order.at(i) != tracks.at(i)->serial());
+    }
+    if(!changed)
+    {
+        return;
+    }
+
+    index.clear();
+    for(uint i = 0; i < order.size(); ++i)
+    {
+        index[order.at(i)] = i;
+    }
+
+    FrameArena& next = arenas[1 - current];
+    next.reset();
+    for(auto& h : hypotheses)
+    {
+        State* states = allocate<State>(next, tSize);
+        for(uint i = 0; i < tSize; ++i)
+        {
+            const auto& found = index.find(tracks.at(i)->serial());
+            if(found != index.end())
+            {
+                states[i] = h.states[found->second];
+            }
+            else
+            {
+                //new or restored track: all the hypotheses start from its filter
+                tracks.at(i)->kf->getPosterior(states[i].x, states[i].P);
+            }
+        }
+        h.states = states;
+        h.assignment = nullptr;
+    }
+    current = 1 - current;
+
+    order.resize(tSize);
+    for(uint i = 0; i < tSize; ++i)
+    {
+        order.at(i) = tracks.at(i)->serial();
+    }
+}
+
+void
+MultiHypothesis::associate(const Tracks& tracks, const Detections& detections, assignments_t& assignment)
+{
+    sync(tracks);
+
+    const uint& tSize = tracks.size();
+    const uint& dSize = detections.size();
+    assignment.assign(tSize, -1);
+    if(tSize == 0)
+    {
+        return;
+    }
+
+    //all the tracks are predicted with the same dt
+    const cv::Matx44f& F = tracks.at(0)->kf->F();
+    const cv::Matx44f& Q = tracks.at(0)->kf->Q();
+    const cv::Matx22f& R = tracks.at(0)->kf->R();
+
+    scratch.reset();
+    children.clear();
+    predictions.clear();
+
+    //the detections seen by each cluster are numbered from 0
+    first.resize(tSize + 1);
+    columns.assign(dSize, -1);
+
+    //EXPAND: the k best assignments of each hypothesis
+    for(uint p = 0; p < hypotheses.size(); ++p)
+    {
+        const auto& h = hypotheses.at(p);
+        State* predicted = allocate<State>(scratch, tSize);
+        predictions.push_back(predicted);
+
+        //GATING: the detections each track can take in this hypothesis
+        gated.clear();
+        float base = 0;
+        for(uint i = 0; i < tSize; ++i)
+        {
+            auto& s = predicted[i];
+            s.x = F * h.states[i].x;
+            s.P = F * h.states[i].P * F.t() + Q;
+            const cv::Matx22f& icovar = (s.P.get_minor<2, 2>(0, 0) + R).inv();
+
+            first.at(i) = gated.size();
+            for(uint j = 0; j < dSize; ++j)
+            {
+                const cv::Vec2f d(detections.at(j).x() - s.x(0), detections.at(j).y() - s.x(1));
+                const float& dist = std::sqrt(d.dot(icovar * d));
+                if(dist < gate)
+                {
+                    Gate g;
+                    g.track = i;
+                    g.detection = j;
+                    g.cost = dist;
+                    gated.push_back(g);
+                }
+            }
+
+            //a track without gated detections can only miss
+            if(first.at(i) == int(gated.size()))
+            {
+                base += missCost;
+            }
+        }
+        first.at(tSize) = gated.size();
+
+        //CLUSTERS: the tracks which do not share any gated detection are assigned independently
+        partition(tSize, dSize);
+        options.clear();
+        optionFirst.assign(1, 0);
+        for(uint begin = 0; begin < members.size(); )
+        {
+            uint end = begin + 1;
+            while(end < members.size() && roots.at(members.at(end)) == roots.at(members.at(begin)))
+            {
+                end++;
+            }
+            expand(begin, end, dSize);
+            optionFirst.push_back(options.size());
+            begin = end;
+        }
+
+        //COMBINE: the k best assignments are the k best sums of one assignment for each cluster
+        combos.clear();
+        frontier.clear();
+        Combo start;
+        start.cost = h.cost + base;
+        start.prev = -1;
+        start.option = -1;
+        combos.push_back(start);
+        frontier.push_back(0);
+        for(uint c = 0; c + 1 < optionFirst.size(); ++c)
+        {
+            candidates.clear();
+            for(const auto& f : frontier)
+            {
+                for(int o = optionFirst.at(c); o < optionFirst.at(c + 1); ++o)
+                {
+                    Combo combo;
+                    combo.cost = combos.at(f).cost + options.at(o).cost;
+                    combo.prev = f;
+                    combo.option = o;
+                    candidates.push_back(combo);
+                }
+            }
+
+            const uint& best = std::min(uint(candidates.size()), k);
+            std::partial_sort(candidates.begin(), candidates.begin() + best, candidates.end(),
+                              [](const Combo& a, const Combo& b) { return a.cost < b.cost; });
+            frontier.clear();
+            for(uint n = 0; n < best; ++n)
+            {
+                frontier.push_back(combos.size());
+                combos.push_back(candidates.at(n));
+            }
+        }
+
+        //the assignment of a combination is collected from its options, a miss is the column dSize + track
+        for(const auto& f : frontier)
+        {
+            Child child;
+            child.cost = combos.at(f).cost;
+            child.parent = p;
+            child.assignment = allocate<int>(scratch, tSize);
+            for(uint i = 0; i < tSize; ++i)
+            {
+                child.assignment[i] = dSize + i;
+            }
+            for(int e = f; combos.at(e).option != -1; e = combos.at(e).prev)
+            {
+                const auto& o = options.at(combos.at(e).option);
+                for(uint m = o.begin; m < o.end; ++m)
+                {
+                    child.assignment[members.at(m)] = o.assignment[m - o.begin];
+                }
+            }
+            children.push_back(child);
+        }
+    }
+
+    //SELECT: the k best hypotheses of the frame
+    const uint& kept = std::min(uint(children.size()), k);
+    std::partial_sort(children.begin(), children.begin() + kept, children.end(),
+                      [](const Child& a, const Child& b) { return a.cost < b.cost; });
+
+    //PRUNE: the hypotheses which disagree with the best one on the decisions older than the scan are discarded
+    FrameArena& next = arenas[1 - current];
+    next.reset();
+    survivors.clear();
+    uint64_t root = 0;
+    const float& best = children.at(0).cost;
+    for(uint c = 0; c < kept; ++c)
+    {
+        const auto& child = children.at(c);
+        const auto& parent = hypotheses.at(child.parent);
+
+        Hypothesis h;
+        h.cost = child.cost - best;
+        h.ancestors[0] = ++nodes;
+        std::copy(parent.ancestors, parent.ancestors + max_scan, h.ancestors + 1);
+        if(c == 0)
+        {
+            root = h.ancestors[scan];
+        }
+        else if(h.ancestors[scan] != root)
+        {
+            continue;
+        }
+
+        //UPDATE: the states of the surviving hypotheses are corrected with their assignment
+        h.states = allocate<State>(next, tSize);
+        h.assignment = allocate<int>(next, tSize);
+        const State* predicted = predictions.at(child.parent);
+        for(uint i = 0; i < tSize; ++i)
+        {
+            const auto& j = child.assignment[i];
+            const auto& p = predicted[i];
+            auto& s = h.states[i];
+            if(j < int(dSize))
+            {
+                const cv::Matx22f& S = p.P.get_minor<2, 2>(0, 0) + R;
+                const cv::Matx<float, 4, 2>& K = p.P.get_minor<4, 2>(0, 0) * S.inv();
+                const cv::Matx21f v(detections.at(j).x() - p.x(0), detections.at(j).y() - p.x(1));
+                s.x = p.x + K * v;
+                s.P = p.P - K * p.P.get_minor<2, 4>(0, 0);
+                h.assignment[i] = j;
+            }
+            else
+            {
+                s = p;
+                h.assignment[i] = -1;
+            }
+        }
+        survivors.push_back(h);
+    }
+
+    std::swap(hypotheses, survivors);
+    current = 1 - current;
+
+    const auto& h = hypotheses.at(0);
+    assignment.assign(h.assignment, h.assignment + tSize);
+}
+
+void
+MultiHypothesis::commit(const Tracks& tracks)
+{
+    const auto& h = hypotheses.at(0);
+    if(h.states == nullptr)
+    {
+        return;
+    }
+
+    //the tracks created after the association are appended: the first ones are still in order
+    for(uint i = 0; i < order.size() && i < tracks.size(); ++i)
+    {
+        if(tracks.at(i)->serial() == order.at(i))
+        {
+            tracks.at(i)->kf->setPosterior(h.states[i].x, h.states[i].P);
+        }
+    }
+}
+
+void
+MultiHypothesis::shift(const Track_ptr& track, const cv::Matx41f& delta)
+{
+    //a track created after the association has no state in the hypotheses yet
+    const auto& found = std::find(order.begin(), order.end(), track->serial());
+    if(found == order.end())
+    {
+        return;
+    }
+
+    const auto& i = found - order.begin();
+    for(auto& h : hypotheses)
+    {
+        if(h.states != nullptr)
+        {
+            h.states[i].x += delta;
+        }
+    }
+}
+
+int
+MultiHypothesis::find(int i)
+{
+    while(parent.at(i) != i)
+    {
+        parent.at(i) = parent.at(parent.at(i));
+        i = parent.at(i);
+    }
+    return i;
+}
+
+void
+MultiHypothesis::partition(const uint& tSize, const uint& dSize)
+{
+    //two tracks are in the same cluster if they share a gated detection
+    parent.resize(tSize);
+    std::iota(parent.begin(), parent.end(), 0);
+    owner.assign(dSize, -1);
+    for(const auto& g : gated)
+    {
+        auto& o = owner.at(g.detection);
+        if(o == -1)
+        {
+            o = g.track;
+        }
+        else
+        {
+            parent.at(find(g.track)) = find(o);
+        }
+    }
+
+    roots.resize(tSize);
+    members.clear();
+    for(uint i = 0; i < tSize; ++i)
+    {
+        roots.at(i) = find(i);
+        if(first.at(i + 1) > first.at(i))
+        {
+            members.push_back(i);
+        }
+    }
+    std::stable_sort(members.begin(), members.end(), [this](const int& a, const int& b) { return roots.at(a) < roots.at(b); });
+}
+
+void
+MultiHypothesis::expand(const uint& begin, const uint& end, const uint& dSize)
+{
+    const uint& rows = end - begin;
+
+    //the columns are the detections gated by the cluster and one miss column for each of its tracks
+    clusterDetections.clear();
+    for(uint r = 0; r < rows; ++r)
+    {
+        const auto& i = members.at(begin + r);
+        for(int g = first.at(i); g < first.at(i + 1); ++g)
+        {
+            auto& c = columns.at(gated.at(g).detection);
+            if(c == -1)
+            {
+                c = clusterDetections.size();
+                clusterDetections.push_back(gated.at(g).detection);
+            }
+        }
+    }
+
+    const uint& nDets = clusterDetections.size();
+    const uint& cols = nDets + rows;
+    costs.assign(rows * cols, forbidden);
+    for(uint r = 0; r < rows; ++r)
+    {
+        const auto& i = members.at(begin + r);
+        for(int g = first.at(i); g < first.at(i + 1); ++g)
+        {
+            costs.at(r + columns.at(gated.at(g).detection) * rows) = gated.at(g).cost;
+        }
+        costs.at(r + (nDets + r) * rows) = missCost;
+    }
+
+    kbest(costs, rows, cols, k, solutions);
+    for(const auto& solution : solutions)
+    {
+        Option o;
+        o.cost = solution.cost;
+        o.begin = begin;
+        o.end = end;
+        o.assignment = allocate<int>(scratch, rows);
+        for(uint r = 0; r < rows; ++r)
+        {
+            const auto& c = solution.solution[r];
+            o.assignment[r] = (c < int(nDets)) ? clusterDetections.at(c) : int(dSize + members.at(begin + r));
+        }
+        options.push_back(o);
+    }
+
+    for(const auto& d : clusterDetections)
+    {
+        columns.at(d) = -1;
+    }
+}
+
+void
+MultiHypothesis::kbest(const distMatrix_t& cost, const uint& rows, const uint& cols, const uint& k, std::vector<Node>& solutions)
+{
+    solutions.clear();
+    queue.clear();
+
+    Node root;
+    root.fixed = allocate<int>(scratch, rows);
+    std::fill(root.fixed, root.fixed + rows, -1);
+    root.excluded = nullptr;
+    root.nExcluded = 0;
+    root.solution = allocate<int>(scratch, rows);
+    if(solve(cost, rows, cols, root))
+    {
+        queue.push_back(root);
+    }
+
+    while(queue.size() > 0 && solutions.size() < k)
+    {
+        //the cheapest subproblem gives the next best assignment
+        uint best = 0;
+        for(uint i = 1; i < queue.size(); ++i)
+        {
+            if(queue.at(i).cost < queue.at(best).cost)
+            {
+                best = i;
+            }
+        }
+        const Node node = queue.at(best);
+        queue.at(best) = queue.back();
+        queue.pop_back();
+
+        solutions.push_back(node);
+        if(solutions.size() == k)
+        {
+            break;
+        }
+
+        //partition: the child r keeps the choices of the rows before r and excludes the choice of the row r
+        int* fixed = allocate<int>(scratch, rows);
+        std::copy(node.fixed, node.fixed + rows, fixed);
+        for(uint r = 0; r < rows; ++r)
+        {
+            if(node.fixed[r] != -1)
+            {
+                continue;
+            }
+
+            //a row with no other admissible column cannot change its choice
+            uint options = 0;
+            for(uint c = 0; c < cols && options < 2; ++c)
+            {
+                if(cost.at(r + c * rows) < forbidden)
+                {
+                    options++;
+                }
+            }
+
+            if(options > 1)
+            {
+                Node child;
+                child.fixed = allocate<int>(scratch, rows);
+                std::copy(fixed, fixed + rows, child.fixed);
+                child.nExcluded = node.nExcluded + 1;
+                child.excluded = allocate< std::pair<int, int> >(scratch, child.nExcluded);
+                std::copy(node.excluded, node.excluded + node.nExcluded, child.excluded);
+                child.excluded[node.nExcluded] = std::make_pair(int(r), node.solution[r]);
+                child.solution = allocate<int>(scratch, rows);
+                if(solve(cost, rows, cols, child))
+                {
+                    queue.push_back(child);
+                }
+            }
+            fixed[r] = node.solution[r];
+        }
+    }
+}
+
+bool
+MultiHypothesis::solve(const distMatrix_t& cost, const uint& rows, const uint& cols, Node& node)
+{
+    work.assign(cost.begin(), cost.end());
+    for(uint e = 0; e < node.nExcluded; ++e)
+    {
+        work.at(node.excluded[e].first + node.excluded[e].second * rows) = forbidden;
+    }
+
+    //a fixed pair is the only admissible choice of its row and of its column
+    for(uint r = 0; r < rows; ++r)
+    {
+        const auto& c = node.fixed[r];
+        if(c == -1)
+        {
+            continue;
+        }
+        for(uint j = 0; j < cols; ++j)
+        {
+            if(int(j) != c)
+            {
+                work.at(r + j * rows) = forbidden;
+            }
+        }
+        for(uint i = 0; i < rows; ++i)
+        {
+            if(i != r)
+            {
+                work.at(i + c * rows) = forbidden;
+            }
+        }
+    }
+
+    solver.Solve(work, rows, cols, assignments, AssignmentProblemSolver::optimal);
+
+    node.cost = 0;
+    for(uint r = 0; r < rows; ++r)
+    {
+        const auto& c = assignments.at(r);
+        if(c == -1 || work.at(r + c * rows) >= forbidden)
+        {
+            return false;
+        }
+        node.solution[r] = c;
+        node.cost += work.at(r + c * rows);
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+#include "reid_gallery.h"
+
+using namespace mctracker::tracker;
+
+ReidGallery
+::ReidGallery(const uint& _capacity, const double& _ttl, const float& _threshold, const float& _speed, 
+              const uint& _links, const uint& _efConstruction, const uint& _efSearch)
+    : capacity(_capacity), ttl(_ttl), threshold(_threshold), speed(_speed), count(0), stamps(0), 
+      index(_links, _efConstruction, _efSearch)
+{
+    entries.resize(capacity);
+    freeSlots.reserve(capacity);
+    for(int i = int(capacity) - 1; i >= 0; --i)
+    {
+        freeSlots.push_back(i);
+    }
+}
+
+void
+ReidGallery::insert(const int& label, const cv::Scalar& color, const cv::Mat& hist, const cv::Point2f& position)
+{
+    if(capacity == 0)
+    {
+        return;
+    }
+
+    //a full gallery forgets its oldest identity
+    while(freeSlots.size() == 0 && fifo.size() > 0)
+    {
+        const auto oldest = fifo.front();
+        fifo.pop_front();
+        const auto& e = entries.at(oldest.first);
+        if(e.used && e.stamp == oldest.second)
+        {
+            erase(oldest.first);
+        }
+    }
+
+    const int slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    auto& e = entries.at(slot);
+    e.label = label;
+    e.color = color;
+    e.position = position;
+    e.time = TrackerClock::instance()->now();
+    e.used = true;
+    e.stamp = ++stamps;
+    Appearance::describe(hist, descriptor);
+    index.insert(slot, descriptor);
+    fifo.push_back(std::make_pair(slot, e.stamp));
+    count++;
+}
+
+bool
+ReidGallery::revive(const cv::Mat& hist, const cv::Point2f& position, int& label, cv::Scalar& color)
+{
+    if(count == 0)
+    {
+        return false;
+    }
+
+    //the most similar identities are the candidates, the first one which could be here takes the track
+    Appearance::describe(hist, descriptor);
+    index.search(descriptor, candidates, results);
+    const double& now = TrackerClock::instance()->now();
+    for(const auto& r : results)
+    {
+        if(1.f - r.first < threshold)
+        {
+            break;
+        }
+
+        const auto& e = entries.at(r.second);
+        const cv::Point2f& d = position - e.position;
+        const double& reach = speed * std::max(now - e.time, 0.) + min_radius;
+        if(d.x * d.x + d.y * d.y <= reach * reach)
+        {
+            label = e.label;
+            color = e.color;
+            erase(r.second);
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ReidGallery::expire()
+{
+    const double& now = TrackerClock::instance()->now();
+    while(fifo.size() > 0)
+    {
+        const auto oldest = fifo.front();
+        const auto& e = entries.at(oldest.first);
+        if(e.used && e.stamp == oldest.second)
+        {
+            //the identities are queued by time: the first one still alive stops the scan
+            if(now - e.time <= ttl)
+            {
+                break;
+            }
+            erase(oldest.first);
+        }
+        fifo.pop_front();
+    }
+}
+
+void
+ReidGallery::erase(const int& slot)
+{
+    auto& e = entries.at(slot);
+    index.erase(slot);
+    e.used = false;
+    freeSlots.push_back(slot);
+    count--;
+}
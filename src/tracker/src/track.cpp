@@ -2,18 +2,46 @@
 
 using namespace mctracker::tracker;
 
+std::atomic<uint64_t> Track::serials(0);
+
 Track
 ::Track(const float& _x, const float& _y,  const KalmanParam& _param, const cv::Mat& h, const int cameraNum)
-  : Entity(), hist(h)
+  : Entity()
 {
-    kf = std::shared_ptr<KalmanFilter>(new KalmanFilter(_x, _y,  _param.getDt()));
+    init(_x, _y, _param, h, cameraNum);
+}
+
+void 
+Track::init(const float& _x, const float& _y,  const KalmanParam& _param, const cv::Mat& h, const int cameraNum)
+{
+    //a recycled track keeps its kalman filter and histogram buffers
+    if(!kf)
+    {
+        kf = std::shared_ptr<KalmanFilter>(new KalmanFilter(_x, _y,  _param.getDt()));
+    }
+    else
+    {
+        kf->init(_x, _y, _param.getDt());
+    }
+    h.copyTo(hist);
     ntimes_propagated = 0;
     freezed = 0;
     ntime_missed = 0;
     isgood = false;
     m_label = -1;
-    time = (double)cv::getTickCount();
-    sizes.resize(cameraNum);
+    m_serial = ++serials;
+    color = cv::Scalar();
+    time = TrackerClock::instance()->now();
+    time_in_sec = 0;
+    sizes.assign(cameraNum, cv::Size());
+    points.clear();
+    
+    auto length = std::max(_param.getHistory(), 1u);
+    if(length > max_history)
+    {
+        length = max_history;
+    }
+    m_history.setLimit(length);
 }
 
 const cv::Mat
@@ -22,9 +50,9 @@ Track::update()
     if(points.size() > 0)
     {
         cv::Point2f result(0,0);
-        for(const auto& p : points)
+        for(uint i = 0; i < points.size(); ++i)
         {
-            result += p;
+            result += points[i];
         }
         
         const auto& correction = correct(result.x, result.y);
@@ -42,19 +70,61 @@ const cv::Mat
 Track::predict()
 {
     const auto& prediction = kf->predict();
-    m_history.push_back(cv::Point2f(prediction.at<float>(0), prediction.at<float>(1)));
-    checkHistory();
+    record(prediction);
+    return prediction;
+}
+
+const cv::Mat 
+Track::predict(const cv::Matx41f& x, const cv::Matx44f& P)
+{
+    kf->setPrediction(x, P);
+    const auto& prediction = kf->getPrediction();
+    record(prediction);
     return prediction;
 }
 
+void 
+Track::record(const cv::Mat& prediction)
+{
+    //the oldest position is dropped from the history, it is kept only in the log
+    cv::Point evicted;
+    if(m_history.push_back(cv::Point2f(prediction.at<float>(0), prediction.at<float>(1)), evicted) && m_label != -1)
+    {
+        TrajectoryLog::instance()->write(m_label, m_history.size(), evicted);
+    }
+}
+
+void 
+Track::spill()
+{
+    if(m_label == -1)
+    {
+        return;
+    }
+    
+    const auto& log = TrajectoryLog::instance();
+    const uint& size = m_history.size();
+    for(uint i = 0; i < size; ++i)
+    {
+        log->write(m_label, size - 1 - i, m_history[i]);
+    }
+    m_history.clear();
+}
+
 const cv::Mat 
 Track::correct(const float& _x, const float& _y)
 {
     ntimes_propagated++;
-    time_in_sec = ((double) cv::getTickCount()  - time) / cv::getTickFrequency();
+    time_in_sec = TrackerClock::instance()->now() - time;
     return kf->correct(_x, _y);
 }
 
+const cv::Mat 
+Track::correctLate(const float& _x, const float& _y, const float& lag)
+{
+    return kf->correctLate(_x, _y, lag);
+}
+
 const cv::Point2f 
 Track::getPoint()
 {
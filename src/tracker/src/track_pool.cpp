@@ -0,0 +1,76 @@
+#include "track_pool.h"
+
+using namespace mctracker::tracker;
+
+std::shared_ptr<TrackPool> TrackPool::m_instance = nullptr;
+
+std::shared_ptr<TrackPool>
+TrackPool::instance()
+{
+    if(!m_instance)
+    {
+        m_instance = std::shared_ptr<TrackPool>(new TrackPool);
+    }
+
+    return m_instance;
+}
+
+void
+TrackPool::grow()
+{
+    //the tracks are default constructed: their buffers are allocated at the first use and then reused
+    storage->slabs.push_back(std::unique_ptr<Track[]>(new Track[slab_size]));
+    Track* slab = storage->slabs.back().get();
+    for(int i = int(slab_size) - 1; i >= 0; --i)
+    {
+        storage->freeTracks.push_back(slab + i);
+    }
+    storage->capacity += slab_size;
+    storage->fresh += slab_size;
+}
+
+TrackPool::Track_ptr
+TrackPool::acquire(const float& _x, const float& _y, const KalmanParam& _param, const cv::Mat& _h, const int cameraNum)
+{
+    Track* track;
+    {
+        std::lock_guard<std::mutex> lock(storage->mtx);
+        if(storage->freeTracks.empty())
+        {
+            grow();
+        }
+        
+        //the released tracks are stacked above the ones never used
+        if(storage->freeTracks.size() > storage->fresh)
+        {
+            storage->recycled++;
+        }
+        else
+        {
+            storage->fresh--;
+        }
+
+        track = storage->freeTracks.back();
+        storage->freeTracks.pop_back();
+        storage->used++;
+        storage->peak = std::max(storage->peak, storage->used);
+    }
+
+    track->init(_x, _y, _param, _h, cameraNum);
+
+    std::shared_ptr<Storage> owner = storage;
+    return Track_ptr(track, [owner](Track* t)
+    {
+        std::lock_guard<std::mutex> lock(owner->mtx);
+        owner->freeTracks.push_back(t);
+        owner->used--;
+    });
+}
+
+void
+TrackPool::print()
+{
+    std::lock_guard<std::mutex> lock(storage->mtx);
+    std::cout << "[TRACK POOL]: " << storage->used << "/" << storage->capacity << " in use, peak " << storage->peak
+              << ", recycled " << storage->recycled << std::endl;
+}
@@ -0,0 +1,60 @@
+#include "track_snapshot.h"
+
+using namespace mctracker::tracker;
+
+void
+TrackSnapshot::draw(std::vector<cv::Mat>& images, const std::vector<Camera>& cameras) const
+{
+    std::vector<const TrackState*> good;
+    std::vector<cv::Point2f> points, imPoints;
+    for(const auto& state : m_states)
+    {
+        if(state.good)
+        {
+            good.push_back(&state);
+            points.push_back(cv::Point2f(state.x, state.y));
+        }
+    }
+
+    auto i = 0;
+    for(auto& img : images)
+    {
+        cameras.at(i).world2camera(points, imPoints);
+        auto j = 0;
+        for(const auto& state : good)
+        {
+            const cv::Scalar color(state->color[0], state->color[1], state->color[2]);
+            const cv::Size size(state->widths[i], state->heights[i]);
+            tools::Drawing::box(imPoints.at(j++), size, color, std::to_string(state->label), img);
+        }
+        ++i;
+    }
+}
+
+void
+TrackSnapshot::drawPlanView(cv::Mat& img, bool history) const
+{
+    for(const auto& state : m_states)
+    {
+        if(!state.good)
+        {
+            continue;
+        }
+
+        const cv::Scalar color(state.color[0], state.color[1], state.color[2]);
+        const cv::Point2f p(state.x, state.y);
+        cv::circle(img, p, 3, color, -1);
+        cv::putText(img, std::to_string(state.label).c_str(), p, cv::FONT_HERSHEY_SIMPLEX,
+                            0.55, cv::Scalar(0, 255, 0), 2, CV_AA);
+
+        if(history)
+        {
+            Points points;
+            for(auto k = 0; k < state.historySize; ++k)
+            {
+                points.push_back(cv::Point(state.history[k][0], state.history[k][1]));
+            }
+            tools::Drawing::history(points, color, img);
+        }
+    }
+}
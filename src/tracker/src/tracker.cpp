@@ -4,11 +4,54 @@ using namespace mctracker::tracker;
 
 Tracker
 ::Tracker(const KalmanParam& _param, const std::vector<Camera>& camerastack)
-    : streams(camerastack)
+    : streams(camerastack), fovMap(camerastack),
+      frozen(_param.getAnnLinks(), _param.getAnnEfConstruction(), _param.getAnnEfSearch())
 {
     param = _param;
-    rng = cv::RNG(12345);
+    frozenIds = 0;
+    rng = cv::RNG(param.getSeed());
     trackIds = 1;
+    last_timestamp = -1;
+    frames = 0;
+    
+    //the positions dropped from the histories of the tracks are stored on disk
+    if(!param.getTrajectoryLog().empty())
+    {
+        TrajectoryLog::instance()->open(param.getTrajectoryLog());
+    }
+    
+    //the input of each step is recorded for replaying the run
+    if(!param.getDetectionLog().empty())
+    {
+        recorder.create(param.getDetectionLog());
+    }
+    
+    //the association keeps several hypotheses in MHT mode
+    if(param.getAssociation() == "MHT")
+    {
+        mht = std::make_shared<MultiHypothesis>(param.getMhtHypotheses(), param.getMhtScan(), 
+                                                param.getAssocdummycost(), association_thresh);
+    }
+    else if(param.getAssociation() == "JPDA")
+    {
+        jpda = std::make_shared<Jpda>(param.getJpdaPd(), param.getJpdaClutter(), param.getJpdaEvents(), association_thresh);
+    }
+    
+    //the tracks mix several motion models in IMM mode
+    if(param.getMotionModel() == "IMM")
+    {
+        imm = std::make_shared<ImmBank>(param.getImmStay(), param.getImmTurnRate(), param.getDt());
+    }
+    
+    //the identities of the lost tracks can be given back to new tracks
+    if(param.getReidGallery() > 0)
+    {
+        gallery = std::make_shared<ReidGallery>(param.getReidGallery(), param.getReidTtl(), param.getReidThresh(), 
+                                                param.getReidSpeed(), param.getAnnLinks(), param.getAnnEfConstruction(), param.getAnnEfSearch());
+    }
+    
+    //in deterministic mode the time of the tracks is the time of the frames
+    TrackerClock::instance()->setManual(param.isDeterministic());
     numCams = streams.size();
     if(numCams > 10 || numCams == 0)
     {
@@ -47,11 +90,9 @@ Tracker::refine_detections(std::vector<Detections>& _detections)
     auto m = 0;
     for(auto& det : _detections)
     {
-        const auto& fov = streams.at(m).getFOV();
         for(int i = int(det.size()) - 1; i >= 0 ; --i)
         {
-            if(det.at(i).y() < 0 || det.at(i).x() < 0 || det.at(i).y() > fov.rows || det.at(i).x() > fov.cols ||  
-                int(fov.at<uchar>(cv::Point2i(det.at(i).x(), det.at(i).y()))) != 255)
+            if(!fovMap.isVisible(cv::Point2f(det.at(i).x(), det.at(i).y()), m))
             {
                 det.erase(det.begin() + i);
             }
@@ -61,124 +102,123 @@ Tracker::refine_detections(std::vector<Detections>& _detections)
 }
 
 
-Detections 
-Tracker::first_assosiation(std::vector<Detections>& observations)
+void 
+Tracker::fuse_detections(const std::vector<Detections>& _detections, FrameVector<Cluster>& clusters, Detections& detections)
 {
-    Detections detections;
-    std::vector< std::vector<bool> > checked(observations.size());
+    const ArenaAllocator<char> alloc(arena);
+    FrameVector<cv::Point2f> centroids(alloc);
+    FrameVector<float> weights(alloc);
+    const auto& radius = param.getFusionRadius();
     
-    for(auto i = 0; i < int(observations.size()); ++i)
-    {
-        checked.at(i).resize(observations.at(i).size(), false);
-    }
+    clusters.clear();
+    detections.clear();
     
-    std::vector< std::vector< std::pair<int, int> > > associations; //camera, idx_detection
-    //scroll the observations from the camera i
-    for(auto i = 0; i < int(observations.size() - 1); ++i)
+    //scroll the observations camera by camera, each of them joins the clusters built so far
+    for(auto m = 0; m < int(_detections.size()); ++m)
     {
-        //assign the obeservations
-        const auto& points_i = observations.at(i);
-        auto m = 0;
-        //compare each point of the camera i with all the points of the other cameras
-        for(const auto& pi : points_i)
+        const auto& det = _detections.at(m);
+        const auto& prob = cameraProbabilities.at(m);
+        const uint& cSize = clusters.size();
+        const uint& dSize = det.size();
+        
+        FrameVector<char> fused(dSize, false, alloc);
+        
+        if(cSize > 0 && dSize > 0)
         {
-            std::vector< std::pair<int, int> > association;
-            //if the point is not already checked
-            if(!checked[i][m])
+            //COMPUTE COSTS
+            auto& assignments = assignment_buffer;
+            auto& cost = cost_buffer;
+            cost.resize(cSize * dSize);
+            
+            for(uint i = 0; i < cSize; ++i)
             {
-                //insert the point in the local association
-                association.push_back(std::make_pair(i, m));
-                
-                //take the obeservations for the other camera j (i+1)
-                for(auto j = i + 1; j < int(observations.size()); j++)
+                for(uint j = 0; j < dSize; ++j)
                 {
-                    const auto& points_j = observations.at(j);
-                    auto min_dist = std::numeric_limits<float>::max();
-                    auto idx = -1;
-                    auto  k = 0;
-                    //scroll all the obeservations of the camera j
-                    for(const auto& pj : points_j)
-                    {
-                        //if the point is not checked
-                        if(!checked[j][k])
-                        {
-                            //I compute the distance
-                            auto p = cv::Point2f(pi.x() - pj.x(), pi.y() - pj.y());
-                            float dist = sqrt( p.x * p.x + p.y * p.y);
-
-                            if(dist < min_dist)
-                            {
-                                min_dist = dist;
-                                idx = k;
-                            }
-                        }
-                        ++k;
-                    }
-                    
-                    //if the distance is less than 30 pixel
-                    // the point included in the observesion j 
-                    // is added to the point related to the
-                    // observation i
-                    if(min_dist < 30 && idx != -1)
-                    {
-                        //set the point as checked
-                        checked[j][idx] = true;
-                        association.push_back(std::make_pair(j, idx));
-                    }
+                    const auto& p = cv::Point2f(centroids.at(i).x - det.at(j).x(), centroids.at(i).y - det.at(j).y());
+                    const float& dist = sqrt(p.x * p.x + p.y * p.y);
+                    //the points outside the gate cannot be fused together
+                    cost.at(i + j * cSize) = (dist < radius) ? dist : gated_cost;
                 }
             }
-            if(association.size() > 0)
-                associations.push_back(association);
             
-            checked[i][m] = true;
-            ++m;
+            //compute the munkres algorithm
+            solver.Solve(cost, cSize, dSize, assignments, AssignmentProblemSolver::optimal);
+            
+            for(uint i = 0; i < assignments.size(); ++i)
+            {
+                const auto& j = assignments[i];
+                if(j != -1 && cost.at(i + j * cSize) < radius)
+                {
+                    //update the weighted centroid of the cluster
+                    const auto& w = weights.at(i);
+                    centroids.at(i).x = (w * centroids.at(i).x + prob * det.at(j).x()) / (w + prob);
+                    centroids.at(i).y = (w * centroids.at(i).y + prob * det.at(j).y()) / (w + prob);
+                    weights.at(i) += prob;
+                    clusters.at(i).push_back(std::make_pair(m, j));
+                    fused.at(j) = true;
+                }
+            }
+        }
+        
+        //the detections which are not fused start a new cluster
+        for(uint j = 0; j < dSize; ++j)
+        {
+            if(!fused.at(j))
+            {
+                centroids.push_back(cv::Point2f(det.at(j).x(), det.at(j).y()));
+                weights.push_back(prob);
+                clusters.push_back(Cluster(1, std::make_pair(m, int(j)), alloc));
+            }
         }
     }
     
-    
-    for(const auto& association : associations)
+    auto i = 0;
+    for(const auto& cluster : clusters)
     {
-        if(association.size() == 1)
+        //size and histogram are taken from the most reliable camera of the cluster
+        auto best = cluster.at(0);
+        for(const auto& member : cluster)
         {
-            const auto& idx = association.at(0);
-            const auto& obs = observations[idx.first][idx.second];
-            Detection d(obs.x(),   obs.y(), obs.w(), obs.h(), obs.hist());
-            detections.push_back(d);
-        }
-        else
-        {
-            Detection d;
-            float prob;
-            d.setX(0.);
-            d.setY(0.);
-            
-            for(const auto& ass : association)
+            if(cameraProbabilities.at(member.first) > cameraProbabilities.at(best.first))
             {
-                prob = cameraProbabilities.at(ass.first);
-                const auto& obs = observations[ass.first][ass.second];
-                d.setX(d.x() + prob*obs.x());
-                d.setY(d.y() + prob*obs.y());
-                if(streams.at(ass.first).getProximity())
-                {
-                    d.setHist(obs.hist());
-                }
-                d.setSize(obs.w(), obs.h());
+                best = member;
             }
-            
-            detections.push_back(d);
         }
+        
+        const auto& obs = _detections[best.first][best.second];
+        detections.push_back(Detection(centroids.at(i).x, centroids.at(i).y, obs.w(), obs.h(), obs.hist()));
+        ++i;
     }
-    
-    return detections;
 }
 
 void 
-Tracker::track(std::vector< Detections >& _detections, const int& w, const int& h)
+Tracker::track(std::vector< Detections >& _detections, const int& w, const int& h, const double& timestamp)
 {
-    //prediction
-    evolveTracks();
+    if(recorder.isRecording())
+    {
+        recorder.write(_detections, std::vector<double>(1, timestamp), w, h);
+    }
+    step(_detections, w, h, timestamp);
+    publish(timestamp);
+}
+
+void 
+Tracker::step(std::vector< Detections >& _detections, const int& w, const int& h, const double& timestamp)
+{
+    //the temporaries of the previous frame are released all at once
+    arena.reset();
+    TrajectoryLog::instance()->setFrame(frames);
+    if(param.isDeterministic())
+    {
+        TrackerClock::instance()->set((timestamp >= 0) ? timestamp : frames / param.getFps());
+    }
     
-    auto d = _detections;
+    //the identities lost for too long are forgotten
+    if(gallery)
+        gallery->expire();
+    
+    //prediction
+    evolveTracks(elapsed(timestamp));
     
     //check if the detections are in the FOV of the cameras
     refine_detections(_detections);
@@ -186,44 +226,175 @@ Tracker::track(std::vector< Detections >& _detections, const int& w, const int&
     //check if the freezed tracks can be restored
     if(old_tracks.size() > 0)
         check_old_tracks(_detections);
-
-
-    //assign the new observations to the tracklets
-    std::vector<cv::Mat> assignments(_detections.size());
-    
-    auto i = 0;
-    for(const auto& det : _detections)
-    {
-        assignments.at(i) = associate_tracks(det).clone();
-
-        if(assignments.at(i).total() != 0)
-            Hyphothesis::instance()->new_hyphothesis(assignments.at(i), single_tracks, det, w, h, 
-                                                                                    param.getNewhypdummycost(), prev_unassigned, param, (streams.size()));
-        assignments.at(i).setTo(0, (assignments.at(i) == 255));
-    
-        i++;
-    } 
     
+    //fuse the observations of all the cameras
+    FrameVector<Cluster> clusters(arena);
+    fuse_detections(_detections, clusters, fused_detections);
+    const auto& detections = fused_detections;
 
     if(single_tracks.size() == 0)
     {
-        //first association between camera points
-        const auto& detections = first_assosiation(_detections);
-        
         //start new tracks
         for(const auto& t : detections)
         {
-            single_tracks.push_back(Track_ptr(new Track(t.x(), t.y(),  param, t.hist(), int(streams.size()))));
+            single_tracks.push_back(TrackPool::instance()->acquire(t.x(), t.y(),  param, t.hist(), numCams));
         }
     }
     else
     {
+        //assign the fused observations to the tracklets
+        auto& assignment = track_assignment;
+        if(mht)
+            mht->associate(single_tracks, detections, assignment);
+        else if(jpda)
+            jpda->associate(single_tracks, detections, assignment);
+        else
+            associate_tracks(detections, assignment);
+        
+        if(detections.size() != 0)
+            Hyphothesis::instance()->new_hyphothesis(assignment, single_tracks, detections, w, h, 
+                                                                                    param.getNewhypdummycost(), prev_unassigned, param, numCams);
+        
         //update the tracks given the assigments
-        update_tracks(assignments, _detections);
+        update_tracks(assignment, detections, clusters, _detections);
+        //the models of the tracks are corrected and mixed with their likelihoods
+        if(imm)
+            imm->correct(single_tracks, assignment, detections);
+        //the tracks follow the best hypothesis, also when it revises the past decisions
+        if(mht)
+            mht->commit(single_tracks);
+        //the hard assignment drives the life cycle, the state takes the weighted update
+        if(jpda)
+            jpda->commit(single_tracks);
         //delete or freeze the tracks which have no detections
         delete_tracks();
+    }
+}
 
+void 
+Tracker::track(std::vector< Detections >& _detections, const int& w, const int& h, const std::vector<double>& timestamps)
+{
+    if(timestamps.size() != _detections.size())
+    {
+        throw std::invalid_argument("A timestamp is needed for the detections of each camera");
+    }
+    
+    if(recorder.isRecording())
+    {
+        recorder.write(_detections, timestamps, w, h);
+    }
+    
+    //the state is moved to the newest camera
+    const auto& reference = *std::max_element(timestamps.begin(), timestamps.end());
+    const auto& tolerance = .5 / param.getFps();
+    
+    //the late detections are swapped with buffers kept among the frames
+    auto& late = late_detections;
+    late.resize(_detections.size());
+    for(auto m = 0; m < int(_detections.size()); ++m)
+    {
+        late.at(m).clear();
+        if(reference - timestamps.at(m) > tolerance)
+        {
+            late.at(m).swap(_detections.at(m));
+        }
+    }
+    
+    step(_detections, w, h, reference);
+    
+    //the late detections refine the updated tracks
+    refine_detections(late);
+    for(auto m = 0; m < int(late.size()); ++m)
+    {
+        const float& lag = (reference - timestamps.at(m)) * param.getFps();
+        if(late.at(m).size() > 0 && lag <= max_lag)
+        {
+            correct_late(late.at(m), lag * param.getDt());
+        }
     }
+    
+    publish(reference);
+}
+
+void 
+Tracker::correct_late(const Detections& late, const float& lag)
+{
+    const uint& tSize = single_tracks.size();
+    const uint& dSize = late.size();
+    
+    if(tSize == 0 || dSize == 0)
+    {
+        return;
+    }
+    
+    //COMPUTE COSTS: the tracks are retrodicted to the acquisition time of the detections
+    auto& assignments = assignment_buffer;
+    auto& cost = cost_buffer;
+    cost.resize(tSize * dSize);
+    
+    cv::Point2f retrodicted;
+    cv::Matx22f icovar;
+    for(uint i = 0; i < tSize; ++i)
+    {
+        single_tracks.at(i)->kf->retrodict(lag, retrodicted, icovar);
+        for(uint j = 0; j < dSize; ++j)
+        {
+            //mahalanobis distance, gated as the other associations
+            const cv::Vec2f d(late.at(j).x() - retrodicted.x, late.at(j).y() - retrodicted.y);
+            const float& dist = std::sqrt(d.dot(icovar * d));
+            cost.at(i + j * tSize) = (dist < association_thresh) ? dist : gated_cost;
+        }
+    }
+    
+    //compute the munkres algorithm
+    solver.Solve(cost, tSize, dSize, assignments, AssignmentProblemSolver::optimal);
+    
+    for(uint i = 0; i < assignments.size(); ++i)
+    {
+        const auto& j = assignments[i];
+        if(j != -1 && cost.at(i + j * tSize) < association_thresh)
+        {
+            const auto& track = single_tracks.at(i);
+            cv::Matx41f before, after;
+            cv::Matx44f P;
+            track->kf->getPosterior(before, P);
+            track->correctLate(late.at(j).x(), late.at(j).y(), lag);
+            
+            //the hypotheses follow the correction, otherwise the next commit would undo it
+            if(mht)
+            {
+                track->kf->getPosterior(after, P);
+                mht->shift(track, after - before);
+            }
+        }
+    }
+}
+
+float 
+Tracker::elapsed(const double& timestamp)
+{
+    if(timestamp < 0)
+    {
+        return param.getDt();
+    }
+    
+    if(last_timestamp < 0)
+    {
+        last_timestamp = timestamp;
+        return param.getDt();
+    }
+    
+    //a repeated or older timestamp adds no time and does not move the clock back
+    if(timestamp <= last_timestamp)
+    {
+        return 0;
+    }
+    
+    //the frames can be dropped: dt is scaled by the number of nominal frames elapsed
+    const float& dt = param.getDt() * (timestamp - last_timestamp) * param.getFps();
+    last_timestamp = timestamp;
+    
+    return dt;
 }
 
 void 
@@ -236,20 +407,17 @@ Tracker::delete_tracks()
 
         if(p.x < 0 || p.x >= int(width) || p.y < 0 || p.y >= int(height) || ntime_missed >= param.getMaxmissed())
         {
-            bool isInside = false;
-            for(const auto& stream : streams)
+            //the track is frozen when at least one camera sees the point, as isVisible does for the detections
+            if(fovMap.cameras(p) != 0)
             {
-                const auto& fov = stream.getFOV();
-                if(int(fov.at<uchar>(p)) != 0)
-                {
-                    isInside = true;
-                    break;
-                }
+                freeze(single_tracks.at(i));
             }
-            
-            if(isInside)
+            else
             {
-                old_tracks.push_back(single_tracks.at(i));
+                //the track left the monitored area: its identity can come back later
+                if(gallery && single_tracks.at(i)->isgood)
+                    gallery->insert(single_tracks.at(i)->label(), single_tracks.at(i)->color, single_tracks.at(i)->histogram(), p);
+                single_tracks.at(i)->spill();
             }
             
             single_tracks.erase(single_tracks.begin() + i);
@@ -258,159 +426,108 @@ Tracker::delete_tracks()
 }
 
 
-cv::Mat 
-Tracker::associate_tracks(const Detections& _detections)
+void 
+Tracker::associate_tracks(const Detections& _detections, assignments_t& assignment)
 {
-    if(_detections.size() == 0) return cv::Mat();
-    cv::Mat assigmentsBin(cv::Size(_detections.size(), single_tracks.size()), CV_8UC1, cv::Scalar(0));
-    assignments_t assignments;
-    distMatrix_t cost(_detections.size() * single_tracks.size());
-    cv::Mat costs(cv::Size(_detections.size(), single_tracks.size()), CV_32FC1);
-    cv::Mat mu;
-    cv::Mat sigma;
-    cv::Point2f t;
-
-
-    //COMPUTE COSTS
     const uint& tSize = single_tracks.size();
     const uint& dSize = _detections.size();
+    
+    assignment.assign(tSize, -1);
+    if(dSize == 0) return;
+    
+    auto& assignments = assignment_buffer;
+    auto& cost = cost_buffer;
+    cost.resize(dSize * tSize);
 
+    //COMPUTE COSTS
     for(uint i = 0; i < tSize; ++i)
     {
-        mu = single_tracks.at(i)->getPrediction();
-        sigma = single_tracks.at(i)->S();
-        t = cv::Point2f(mu.at<float>(0), mu.at<float>(1));
+        const cv::Mat& mu = single_tracks.at(i)->getPrediction();
+        const cv::Matx22f& icovar = single_tracks.at(i)->invS();
         
         for(uint j = 0; j < dSize; ++j)
         {
-            cv::Mat detection(cv::Size(1, 2), CV_32FC1);
-            detection.at<float>(0) = _detections.at(j).x();
-            detection.at<float>(1) = _detections.at(j).y();
             //compute mahalanobis distance costs
-            costs.at<float>(i, j) = cv::Mahalanobis(detection, cv::Mat(t), sigma.inv());
-            cost.at(i + j * single_tracks.size() ) = costs.at<float>(i, j);
+            const cv::Vec2f d(_detections.at(j).x() - mu.at<float>(0), _detections.at(j).y() - mu.at<float>(1));
+            cost.at(i + j * tSize) = std::sqrt(d.dot(icovar * d));
         }
     }
     
     //compute the munkres algorithm
-    AssignmentProblemSolver APS;
-    APS.Solve(cost, single_tracks.size(), _detections.size(), assignments, AssignmentProblemSolver::optimal);
+    solver.Solve(cost, tSize, dSize, assignments, AssignmentProblemSolver::optimal);
     
     for(auto i = 0; i < int(assignments.size()); ++i)
     {
         //check if there is an assigment and if the cost associated to the assignment is less then 
         //a threshold
-        if(costs.at<float>(i, assignments[i]) < association_thresh && assignments[i] != -1)
-            assigmentsBin.at<uchar>(i, assignments[i]) = 1;
+        const auto& j = assignments[i];
+        if(j != -1 && cost.at(i + j * tSize) < association_thresh)
+            assignment.at(i) = j;
     }
-    
-
-
-    return assigmentsBin;
 }
 
 
 
 void 
-Tracker::update_tracks(const std::vector<cv::Mat>& assigments, const std::vector<Detections>& _detections)
+Tracker::update_tracks(const assignments_t& assignment, const Detections& detections, const FrameVector<Cluster>& clusters, 
+                       const std::vector<Detections>& _detections)
 {
-    std::map<int, std::vector<std::pair< int, cv::Rect> > > idx_to_update;
-    std::map<int, std::vector<cv::Mat> >  idx_hists;
-    auto m = 0;
-
-    for(const auto& assignment : assigments)
-    {
-        const uint& aRows = assignment.rows;
-        const uint& aCols = assignment.cols;
-        const auto& detection = _detections.at(m);
-        if(detection.size() > 0)
-        {
-            for(uint i = 0; i  < aRows; ++i)
-            {
-                for(uint j = 0; j < aCols; ++j)
-                {
-                    if(assignment.at<uchar>(i, j) == uchar(1))
-                    {
-                        if(idx_to_update.find(i) != idx_to_update.end())
-                        {
-                            idx_to_update[i].push_back(std::make_pair (m, cv::Rect(detection.at(j).x(), detection.at(j).y(),
-                                detection.at(j).w(), detection.at(j).h())));
-                            idx_hists[i].push_back(detection.at(j).hist());
-                        }
-                        else
-                        {
-                            idx_to_update.insert(std::make_pair(i, std::vector<std::pair< int,cv::Rect> >()));
-                            idx_to_update[i].push_back(std::make_pair(m, cv::Rect(detection.at(j).x(), detection.at(j).y(),
-                                detection.at(j).w(), detection.at(j).h())));
-                            idx_hists.insert(std::make_pair(i, std::vector<cv::Mat>()));
-                            idx_hists[i].push_back(detection.at(j).hist());
-                        }
-                    }
-                }
-            }
-        }
-        ++m;
-    }
+    const uint& aSize = assignment.size();
     
-    for(const auto& idx : idx_to_update)
+    for(uint i = 0; i  < aSize; ++i)
     {
-        const auto& points = idx.second;
-        int id_hist = -1;
-        if(points.size() == 1)
+        const auto& track = single_tracks.at(i);
+        const auto& idx = assignment.at(i);
+        
+        if(idx == -1)
         {
-            single_tracks.at(idx.first)->push_point(points.at(0).second.tl());
-            single_tracks.at(idx.first)->sizes.at(points.at(0).first) = cv::Size(points.at(0).second.width, points.at(0).second.height);
-            single_tracks.at(idx.first)->set_hist(idx_hists[idx.first].at(0));
+            track->ntime_missed++;
+            continue;
         }
-        else
+        
+        //store the size of the object in each view which contributed to the fused detection
+        for(const auto& member : clusters.at(idx))
         {
-            cv::Point2f p(0, 0);
-            for(const auto& point : points)
-            {
-                p.x += (cameraProbabilities.at(point.first) * point.second.x);
-                p.y += (cameraProbabilities.at(point.first) * point.second.y);
-                single_tracks.at(idx.first)->sizes.at(point.first) = cv::Size(point.second.width, point.second.height);
-            }
-            single_tracks.at(idx.first)->push_point(p);
+            const auto& obs = _detections[member.first][member.second];
+            track->sizes.at(member.first) = cv::Size(obs.w(), obs.h());
         }
-               
-        single_tracks.at(idx.first)->update();
-        single_tracks.at(idx.first)->ntime_missed = 0;
         
-        if(id_hist != -1)
-            single_tracks.at(idx.first)->set_hist(idx_hists[idx.first].at(id_hist));
+        const auto& d = detections.at(idx);
+        track->push_point(cv::Point2f(d.x(), d.y()));
+        track->set_hist(d.hist());
+        track->update();
+        track->ntime_missed = 0;
         
-        
-        if(single_tracks.at(idx.first)->nTimePropagation() >= param.getMinpropagate() && !single_tracks.at(idx.first)->isgood)
+        if(track->nTimePropagation() >= param.getMinpropagate() && !track->isgood)
         {
-            single_tracks.at(idx.first)->setLabel(trackIds++);
-            
-            single_tracks.at(idx.first)->setColor(cv::Scalar(rng.uniform(0, 255), rng.uniform(0, 255), 
-                                rng.uniform(0, 255)));
-            single_tracks.at(idx.first)->isgood = true;
-        }
-    }
-
-    for(const auto& assignment : assigments)
-    {
-        cv::Mat ass_sum;
-        cv::reduce(assignment, ass_sum, 1, CV_REDUCE_SUM, CV_32S);
-    
-        for(uint i = 0; i < ass_sum.total(); ++i)
-        {
-            if(ass_sum.at<int>(i) == 0)
+            //a confirmed track takes back a lost identity with the same appearance, if any
+            int label;
+            cv::Scalar color;
+            if(gallery && gallery->revive(track->histogram(), cv::Point2f(d.x(), d.y()), label, color))
+            {
+                track->setLabel(label);
+                track->setColor(color);
+            }
+            else
             {
-                single_tracks.at(i)->ntime_missed++;
+                track->setLabel(trackIds++);
+                
+                track->setColor(cv::Scalar(rng.uniform(0, 255), rng.uniform(0, 255), 
+                                    rng.uniform(0, 255)));
             }
+            track->isgood = true;
         }
     }
-    
 }
 
 void 
 Tracker::check_old_tracks(std::vector<Detections>& _detections)
 {
-    std::vector<cv::Mat> assignents;
+    //flags of the tracks to restore
+    FrameVector<char> to_restore(old_tracks.size(), 0, arena);
+    //the appearance index is used only when there are more frozen tracks than neighbours to compare
+    const auto& nearest = param.getAnnNeighbors();
+    const bool& exact = (nearest == 0 || old_tracks.size() <= nearest);
     for(auto &det : _detections)
     {
         const int& tSize = int(old_tracks.size());
@@ -420,91 +537,92 @@ Tracker::check_old_tracks(std::vector<Detections>& _detections)
         {
         
             //COMPUTE COSTS
-            assignments_t assignments;
-            distMatrix_t cost;
+            auto& assignments = assignment_buffer;
+            auto& cost = cost_buffer;
             
-            cv::Mat costs(cv::Size(det.size(), old_tracks.size()), CV_32FC1);
-            cv::Mat hist_costs(cv::Size(det.size(), old_tracks.size()), CV_32FC1);
-            cv::Mat assigmentsBin(cv::Size(det.size(), old_tracks.size()), CV_8UC1, cv::Scalar(0));
-            
-            cv::Mat mu;
-            cv::Mat sigma;
-            cv::Point2f t;
+            cv::Mat costs = arena.mat(tSize, dSize, CV_32FC1);
+            cv::Mat hist_costs = arena.mat(tSize, dSize, CV_32FC1);
+            // compute the correlation distance
+            const auto& correlation = [&](const int& i, const int& j)
+            {
+                return float(1 - cv::compareHist(det.at(j).hist(), old_tracks.at(i)->histogram(), cv::HISTCMP_CORREL));
+            };
     
             for(auto i = 0; i < tSize; ++i)
             {
-                mu = old_tracks.at(i)->getPrediction();
-                sigma = old_tracks.at(i)->S();
-                t = cv::Point2f(mu.at<float>(0), mu.at<float>(1));
+                const cv::Mat& mu = old_tracks.at(i)->getPrediction();
+                const cv::Matx22f& icovar = old_tracks.at(i)->invS();
                 
                 for(auto j = 0; j < dSize; ++j)
                 {
-                    cv::Mat detection(cv::Size(1, 2), CV_32FC1);
-                    detection.at<float>(0) = det.at(j).x();
-                    detection.at<float>(1) = det.at(j).y();
                     // compute the mahalanobis distance
-                    costs.at<float>(i, j) = cv::Mahalanobis(detection, cv::Mat(t), sigma.inv());
-                    // compute the correlation distance
-                    hist_costs.at<float>(i, j) = 1 - cv::compareHist(det.at(j).hist(), old_tracks.at(i)->histogram(), cv::HISTCMP_CORREL);
+                    const cv::Vec2f d(det.at(j).x() - mu.at<float>(0), det.at(j).y() - mu.at<float>(1));
+                    costs.at<float>(i, j) = std::sqrt(d.dot(icovar * d));
                 }
             }
-            //normalize the costs between 0 and 1
-            cv::normalize(costs, costs, 0., 1., cv::NORM_MINMAX, -1, cv::Mat());
-            //linear combination between Mahalanobis distance costs and histogram costs
-            costs = .6 * costs + .4 *  hist_costs;
             
-            //copy the  matrix of costs into a vector
-            if (costs.isContinuous()) 
-            {
-                cost.assign((float*)costs.data, (float*)costs.data + costs.total());
-            } 
-            else 
+            for(auto j = 0; j < dSize; ++j)
             {
-                for (int i = 0; i < costs.rows; ++i) 
+                if(exact)
+                {
+                    for(auto i = 0; i < tSize; ++i)
+                    {
+                        hist_costs.at<float>(i, j) = correlation(i, j);
+                    }
+                    continue;
+                }
+                
+                //the nearest appearances are compared
+                hist_costs.col(j).setTo(cv::Scalar(-1));
+                Appearance::describe(det.at(j).hist(), descriptor);
+                frozen.search(descriptor, nearest, neighbors);
+                float neutral = neighbors.empty() ? 1.f : 0.f;
+                for(const auto& n : neighbors)
+                {
+                    const auto& i = frozen_index.at(n.second);
+                    hist_costs.at<float>(i, j) = correlation(i, j);
+                    neutral = std::max(neutral, hist_costs.at<float>(i, j));
+                }
+                
+                //and the few tracks right around the detection too, the others take the cost of the farthest neighbour:
+                //they are less similar, but the appearance alone does not rule them out
+                for(auto i = 0; i < tSize; ++i)
                 {
-                    cost.insert(cost.end(), costs.ptr<float>(i), costs.ptr<float>(i)+costs.cols);
+                    if(hist_costs.at<float>(i, j) < 0)
+                    {
+                        hist_costs.at<float>(i, j) = (costs.at<float>(i, j) < near_gate) ? correlation(i, j) : neutral;
+                    }
                 }
             }
+            //normalize the costs between 0 and 1
+            cv::normalize(costs, costs, 0., 1., cv::NORM_MINMAX, -1, cv::noArray());
+            //linear combination between Mahalanobis distance costs and histogram costs
+            cv::addWeighted(costs, .6, hist_costs, .4, 0., costs);
             
-            //computing munkres algorithm
-            AssignmentProblemSolver APS;
-            APS.Solve(cost, old_tracks.size(), det.size(), assignments, AssignmentProblemSolver::optimal);
+            //copy the  matrix of costs into a vector
+            cost.assign((float*)costs.data, (float*)costs.data + costs.total());
             
+            //computing munkres algorithm
+            solver.Solve(cost, tSize, dSize, assignments, AssignmentProblemSolver::optimal);
             
             for(auto i = 0; i < int(assignments.size()); ++i)
             {
                 //check if there is an assigment and if the cost associated to the assignment is less then 
                 //a threshold 
-                if(costs.at<float>(i, assignments[i]) < freezed_thresh && assignments[i] != -1)
-                    assigmentsBin.at<uchar>(i, assignments[i]) = 1;
-            }
-            assignents.push_back(assigmentsBin);
-        }
-    }
-    
-    std::vector<cv::Mat> notAssigned; 
-    std::set<int> notUp;
-    std::set<int, std::greater<int> > to_restore;
-    //check the ids of the tracks to restore
-    for(const auto& assignment : assignents)
-    {
-        for(auto i = 0; i < assignment.rows; ++i)
-        {
-            for(auto j = 0; j < assignment.cols; ++j)
-            {
-                if(assignment.at<uchar>(i, j) == uchar(1))
-                { 
-                    to_restore.insert(i);
-                }
+                if(assignments[i] != -1 && costs.at<float>(i, assignments[i]) < freezed_thresh)
+                    to_restore.at(i) = 1;
             }
         }
     }
 
     //restore the freezed tracks 
-    for(const auto& id : to_restore)
+    for(int id = int(to_restore.size()) - 1; id >= 0; --id)
     {
-        single_tracks.push_back(old_tracks.at(id));
-        old_tracks.erase(old_tracks.begin() + id);
+        if(to_restore.at(id))
+        {
+            single_tracks.push_back(old_tracks.at(id));
+            unfreeze(id);
+        }
     }
     
     
@@ -513,7 +631,13 @@ Tracker::check_old_tracks(std::vector<Detections>& _detections)
         //delete freezed tracks
         if(old_tracks.at(m)->freezed >= param.getMaxmissed())
         {
-            old_tracks.erase(old_tracks.begin() + m);
+            //the identity survives the track in the gallery
+            if(gallery && old_tracks.at(m)->isgood)
+                gallery->insert(old_tracks.at(m)->label(), old_tracks.at(m)->color, old_tracks.at(m)->histogram(), 
+                                old_tracks.at(m)->getPoint());
+            //the track is deleted for good: its remaining history goes to the trajectory log
+            old_tracks.at(m)->spill();
+            unfreeze(m);
         }
         //or increment the number of "freezing" 
         else
@@ -523,6 +647,45 @@ Tracker::check_old_tracks(std::vector<Detections>& _detections)
     }
 }
 
+void 
+Tracker::freeze(const Track_ptr& track)
+{
+    if(param.getAnnNeighbors() > 0)
+    {
+        const int key = frozenIds++;
+        frozen_keys[track->serial()] = key;
+        frozen_index[key] = old_tracks.size();
+        Appearance::describe(track->histogram(), descriptor);
+        frozen.insert(key, descriptor);
+    }
+    old_tracks.push_back(track);
+}
+
+void 
+Tracker::unfreeze(const int& id)
+{
+    const auto& key = frozen_keys.find(old_tracks.at(id)->serial());
+    if(key != frozen_keys.end())
+    {
+        frozen.erase(key->second);
+        frozen_index.erase(key->second);
+        frozen_keys.erase(key);
+    }
+    
+    //the last frozen track takes the place of the removed one: the callers walk the old tracks backwards
+    const int last = int(old_tracks.size()) - 1;
+    if(id != last)
+    {
+        old_tracks.at(id) = old_tracks.at(last);
+        const auto& moved = frozen_keys.find(old_tracks.at(id)->serial());
+        if(moved != frozen_keys.end())
+        {
+            frozen_index.at(moved->second) = id;
+        }
+    }
+    old_tracks.pop_back();
+}
+
 const Entities 
 Tracker::getTracks()
 {
@@ -530,3 +693,66 @@ Tracker::getTracks()
     tracks.insert(tracks.end(), single_tracks.begin(), single_tracks.end());
     return tracks;
 }
+
+void 
+Tracker::publish(const double& timestamp)
+{
+    //a snapshot is allocated only while the readers hold all the previous ones
+    std::shared_ptr<TrackSnapshot> current;
+    for(const auto& s : snapshots)
+    {
+        if(s.use_count() == 1)
+        {
+            //the last reader released it: its reads happen before the refill
+            std::atomic_thread_fence(std::memory_order_acquire);
+            current = s;
+            break;
+        }
+    }
+    if(!current)
+    {
+        current = std::make_shared<TrackSnapshot>(0, 0., std::vector<TrackState>());
+        snapshots.push_back(current);
+    }
+    
+    auto& states = current->m_states;
+    states.resize(single_tracks.size());
+    auto i = 0;
+    for(const auto& track : single_tracks)
+    {
+        auto& state = states.at(i++);
+        const auto& p = track->getPoint();
+        const auto& kfState = track->kf->getState();
+        state.label = track->label();
+        state.x = p.x;
+        state.y = p.y;
+        state.vx = kfState.at<float>(2);
+        state.vy = kfState.at<float>(3);
+        for(auto c = 0; c < 3; ++c)
+        {
+            state.color[c] = cv::saturate_cast<uchar>(track->color[c]);
+        }
+        state.good = track->isgood;
+        state.missed = track->ntime_missed;
+        
+        for(auto m = 0; m < TrackState::max_cameras; ++m)
+        {
+            const auto& sz = (m < int(track->sizes.size())) ? track->sizes.at(m) : cv::Size();
+            state.widths[m] = sz.width;
+            state.heights[m] = sz.height;
+        }
+        
+        const auto& history = track->m_history;
+        const int& offset = std::max(int(history.size()) - TrackState::max_history, 0);
+        state.historySize = int(history.size()) - offset;
+        for(auto k = 0; k < state.historySize; ++k)
+        {
+            state.history[k][0] = history[offset + k].x;
+            state.history[k][1] = history[offset + k].y;
+        }
+    }
+    
+    current->m_frame = frames++;
+    current->m_timestamp = timestamp;
+    std::atomic_store(&snapshot, Snapshot_ptr(current));
+}
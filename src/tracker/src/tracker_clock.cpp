@@ -0,0 +1,39 @@
+#include "tracker_clock.h"
+
+using namespace mctracker::tracker;
+
+std::shared_ptr<TrackerClock> TrackerClock::m_instance = nullptr;
+
+std::shared_ptr<TrackerClock>
+TrackerClock::instance()
+{
+    if(!m_instance)
+    {
+        m_instance = std::shared_ptr<TrackerClock>(new TrackerClock);
+    }
+
+    return m_instance;
+}
+
+double
+TrackerClock::now() const
+{
+    if(manual)
+    {
+        return current;
+    }
+
+    return double(cv::getTickCount()) / cv::getTickFrequency();
+}
+
+void
+TrackerClock::setManual(const bool& enable)
+{
+    manual = enable;
+}
+
+void
+TrackerClock::set(const double& t)
+{
+    current = t;
+}
@@ -0,0 +1,113 @@
+#include "trajectory_log.h"
+
+using namespace mctracker::tracker;
+
+std::shared_ptr<TrajectoryLog> TrajectoryLog::m_instance = nullptr;
+
+std::shared_ptr<TrajectoryLog>
+TrajectoryLog::instance()
+{
+    if(!m_instance)
+    {
+        m_instance = std::shared_ptr<TrajectoryLog>(new TrajectoryLog);
+    }
+
+    return m_instance;
+}
+
+TrajectoryLog
+::~TrajectoryLog()
+{
+    flush();
+}
+
+void
+TrajectoryLog::open(const std::string& file)
+{
+    flush();
+    if(out.is_open())
+    {
+        out.close();
+    }
+
+    out.open(file, std::ios::binary | std::ios::trunc);
+    if(!out.is_open())
+    {
+        throw std::invalid_argument("Invalid trajectory log file: " + file);
+    }
+
+    const uint32_t header = magic;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pending.reserve(flush_size);
+}
+
+void
+TrajectoryLog::setFrame(const uint32_t& _frame)
+{
+    frame = _frame;
+}
+
+void
+TrajectoryLog::write(const int& label, const uint32_t& age, const cv::Point2f& p)
+{
+    if(!out.is_open())
+    {
+        return;
+    }
+
+    TrajectoryRecord record;
+    record.label = label;
+    record.frame = (frame > age) ? frame - age : 0;
+    record.x = p.x;
+    record.y = p.y;
+    pending.push_back(record);
+
+    if(pending.size() >= flush_size)
+    {
+        flush();
+    }
+}
+
+void
+TrajectoryLog::flush()
+{
+    if(out.is_open() && pending.size() > 0)
+    {
+        out.write(reinterpret_cast<const char*>(pending.data()), pending.size() * sizeof(TrajectoryRecord));
+        out.flush();
+    }
+    pending.clear();
+}
+
+bool
+TrajectoryLog::read(const std::string& file, std::vector<TrajectoryRecord>& records)
+{
+    std::ifstream in(file, std::ios::binary);
+    uint32_t header = 0;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header != magic)
+    {
+        return false;
+    }
+
+    records.clear();
+    TrajectoryRecord record;
+    while(in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        records.push_back(record);
+    }
+    return true;
+}
+
+void
+TrajectoryLog::save(const std::string& file, const std::vector<TrajectoryRecord>& records)
+{
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    if(!out.is_open())
+    {
+        throw std::invalid_argument("Invalid trajectory log file: " + file);
+    }
+
+    const uint32_t header = magic;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(TrajectoryRecord));
+}
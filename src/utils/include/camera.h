@@ -25,14 +25,37 @@ namespace mctracker
                  * @param view a string containing the path to the binary image representing the field of view of the cameras
                  * @param homography_file a string containing the path to the homography file
                  * @param prox a bool which if is true means that the camera is close to scene to monitor
+                 * @param resolution the resolution at which the frames are decoded, an empty size means the native one
+                 * @param format a string containing the pixel format of the frames (BGR or GRAY), 
+                 * GRAY is decoded as gray only by a gstreamer pipeline ending with video/x-raw,format=GRAY8 caps, 
+                 * otherwise the frames are decoded in BGR and GRAY only saves the work after the conversion
                  */
-                Camera(const std::string& stream, const std::string& view, const std::string& homography_file, bool prox);
+                Camera(const std::string& stream, const std::string& view, const std::string& homography_file, bool prox, 
+                       const cv::Size& resolution = cv::Size(), const std::string& format = "BGR");
                 /**
                  * @brief get a frame from the stream
                  * @param frame cv::Mat where the frame is stored
                  * @return true if the frame is read successfully
                  */
                 bool getFrame(cv::Mat& frame);
+                /**
+                 * @brief grab the next frame from the stream without converting it
+                 * @return true if the frame is grabbed successfully
+                 */
+                bool grab();
+                /**
+                 * @brief convert the last grabbed frame to the decode resolution and format, 
+                 * the conversion from the backend is done once for each grabbed frame
+                 * @param frame cv::Mat where the frame is stored
+                 * @param color if true the frame is returned in BGR whatever the format is
+                 * @return true if the frame is retrieved successfully
+                 */
+                bool retrieve(cv::Mat& frame, const bool& color = false);
+                /**
+                 * @brief get the acquisition time of the last grabbed frame
+                 * @return the timestamp in seconds
+                 */
+                double timestamp();
                 
                 /**
                  * @brief convert a point to world coordinates
@@ -47,6 +70,20 @@ namespace mctracker
                  * @return the converted point
                  */
                 cv::Point2f world2camera(const cv::Point2f& p) const;
+                
+                /**
+                 * @brief convert a set of points to world coordinates
+                 * @param points vector of cv::Point2f to convert
+                 * @param projected vector where the converted points are stored
+                 */
+                void camera2world(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& projected) const;
+                
+                /**
+                 * @brief convert a set of points to image coordinates
+                 * @param points vector of cv::Point2f to convert
+                 * @param projected vector where the converted points are stored
+                 */
+                void world2camera(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& projected) const;
             public:
                 /**
                  * @brief get if the camera is close to the scene
@@ -67,10 +104,93 @@ namespace mctracker
                 {
                     return image_view;
                 }
+                
+                /**
+                 * @brief get the size of the frames returned by the camera
+                 * @return the decode resolution
+                 */
+                inline const cv::Size
+                getResolution() const
+                {
+                    return resolution;
+                }
+                
+                /**
+                 * @brief get if the camera returns grayscale frames
+                 * @return true if the format is GRAY
+                 */
+                inline const bool
+                isGray() const
+                {
+                    return gray;
+                }
+            private:
+                /**
+                 * @brief build the lookup table mapping the (distorted) image points to the ground plane
+                 * @param size the size of the camera images
+                 */
+                void build_lut(const cv::Size& size);
+                /**
+                 * @brief look up the world coordinates of an image point with a bilinear interpolation
+                 * @param p the image point
+                 * @param world variable where the world point is stored
+                 * @return true if the point falls inside the lookup table, false otherwise
+                 */
+                bool lookup(const cv::Point2f& p, cv::Point2f& world) const;
+                /**
+                 * @brief convert a set of image points to world coordinates removing the lens distortion
+                 * @param points vector of cv::Point2f to convert
+                 * @param projected vector where the converted points are stored
+                 */
+                void undistort2world(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& projected) const;
+                /**
+                 * @brief apply the lens distortion to a set of undistorted image points
+                 * @param points the points to distort in place
+                 */
+                void distort(std::vector<cv::Point2f>& points) const;
+                /**
+                 * @brief set the decode resolution, using the scaling of the backend if it is available
+                 * @param size the requested resolution
+                 */
+                void set_resolution(const cv::Size& size);
+                /**
+                 * @brief convert a point from the decode resolution to the native one
+                 * @param p the point in decode coordinates
+                 * @return the point in native coordinates
+                 */
+                inline cv::Point2f
+                to_native(const cv::Point2f& p) const
+                {
+                    return cv::Point2f(p.x * sx, p.y * sy);
+                }
+                /**
+                 * @brief convert a point from the native resolution to the decode one
+                 * @param p the point in native coordinates
+                 * @return the point in decode coordinates
+                 */
+                inline cv::Point2f
+                from_native(const cv::Point2f& p) const
+                {
+                    return cv::Point2f(p.x / sx, p.y / sy);
+                }
             private:
                 cv::VideoCapture cap;
+                //the calibration refers to the native resolution
+                cv::Size nativeSize, resolution;
+                float sx, sy;
+                bool gray;
+                //last grabbed frame converted to the decode resolution
+                cv::Mat decoded;
+                bool retrieved;
                 cv::Mat image_view;
                 cv::Mat H, Hinv;
+                //homographies stored row by row for the projections
+                double h[9], h_inv[9];
+                //intrinsics and distortion coefficients (optional)
+                cv::Mat K, distCoeffs;
+                //image to ground lookup table sampled every lutStep pixels
+                cv::Mat lut;
+                int lutStep;
                 bool proximity;
         }; 
     }
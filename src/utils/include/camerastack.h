@@ -35,6 +35,25 @@ namespace mctracker
                  * @return a bool which if true means that the frames have been correctly readed from all the cameras, false otherwise
                  */
                 bool getFrame(std::vector<cv::Mat>& frames);
+                /**
+                 * @brief grab the next frame from all the cameras of the system without converting them
+                 * @return a bool which if true means that the frames have been correctly grabbed from all the cameras, false otherwise
+                 */
+                bool grab();
+                /**
+                 * @brief convert the last frame grabbed from a camera, it can be called concurrently for different cameras
+                 * @param camera the index of the camera
+                 * @param frame cv::Mat where the frame is stored
+                 * @param color if true the frame is returned in BGR whatever the format of the camera is
+                 * @return true if the frame is retrieved successfully
+                 */
+                bool retrieve(const int& camera, cv::Mat& frame, const bool& color = false);
+                /**
+                 * @brief get the acquisition time of the last frame grabbed from a camera
+                 * @param camera the index of the camera
+                 * @return the timestamp in seconds
+                 */
+                double timestamp(const int& camera);
             public:
                 /**
                  * @brief get the vector containing the cameras
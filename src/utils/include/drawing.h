@@ -20,6 +20,7 @@ namespace mctracker
                     static void history(const Points& _history, const cv::Scalar& color, cv::Mat& img);
                     static void arrow(const cv::Point& start_point, const cv::Point& end_point, const cv::Scalar& color, cv::Mat& img);
                     static void rectangle(const cv::Rect& _rect, const cv::Scalar& color, cv::Mat& img);
+                    static void box(cv::Point2f foot, const cv::Size& size, const cv::Scalar& color, const std::string& label, cv::Mat& img);
             };
         }
     }
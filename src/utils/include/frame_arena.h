@@ -0,0 +1,150 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _FRAME_ARENA_H_
+#define _FRAME_ARENA_H_
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+
+namespace mctracker
+{
+    namespace utils
+    {
+        class FrameArena
+        {
+            public:
+                /**
+                 * @brief Constructor class FrameArena
+                 * @param _blockSize the size in bytes of the first block
+                 */
+                FrameArena(const size_t& _blockSize = 1 << 16);
+                /**
+                 * @brief get memory from the arena, it is released only by reset
+                 * @param bytes the number of bytes
+                 * @param alignment the alignment of the memory
+                 * @return a pointer to the memory
+                 */
+                void* allocate(const size_t& bytes, const size_t& alignment = alignof(std::max_align_t));
+                /**
+                 * @brief create a matrix whose data lives in the arena
+                 * @param rows the number of rows
+                 * @param cols the number of columns
+                 * @param type the type of the matrix
+                 * @return the matrix, it must not be used after reset
+                 */
+                cv::Mat mat(const int& rows, const int& cols, const int& type);
+                /**
+                 * @brief release all the memory of the frame, when more blocks have been needed they are merged in a single one
+                 */
+                void reset();
+            public:
+                /**
+                 * @brief get the number of bytes used in the current frame
+                 * @return the number of bytes
+                 */
+                inline const size_t
+                used() const
+                {
+                    return total_used + offset;
+                }
+
+                /**
+                 * @brief get the maximum number of bytes used in a frame
+                 * @return the number of bytes
+                 */
+                inline const size_t
+                peak() const
+                {
+                    return peak_used;
+                }
+
+                /**
+                 * @brief get the number of blocks requested to the system allocator
+                 * @return the number of allocations
+                 */
+                inline const size_t
+                systemAllocations() const
+                {
+                    return system_allocations;
+                }
+            private:
+                /**
+                 * @brief add a block to the arena
+                 * @param size the size in bytes of the block
+                 */
+                void add_block(const size_t& size);
+            private:
+                std::vector< std::unique_ptr<char[]> > blocks;
+                std::vector<size_t> sizes;
+                size_t blockSize;
+                size_t current, offset;
+                //bytes used in the blocks before the current one
+                size_t total_used;
+                size_t peak_used;
+                size_t system_allocations;
+        };
+
+        //std allocator drawing from a frame arena: deallocation is a no-op
+        template<typename T>
+        class ArenaAllocator
+        {
+            public:
+                typedef T value_type;
+            public:
+                /**
+                 * @brief Constructor class ArenaAllocator
+                 * @param _arena the arena where the memory is taken
+                 */
+                ArenaAllocator(FrameArena& _arena) : arena(&_arena) { ; }
+                /**
+                 * @brief Constructor class ArenaAllocator
+                 * @param other allocator of a different type sharing the same arena
+                 */
+                template<typename U>
+                ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) { ; }
+                /**
+                 * @brief allocate memory for n objects
+                 * @param n the number of objects
+                 * @return a pointer to the memory
+                 */
+                T*
+                allocate(const size_t n)
+                {
+                    return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+                }
+                /**
+                 * @brief the memory is released when the arena is reset
+                 */
+                void
+                deallocate(T*, const size_t) { ; }
+            public:
+                FrameArena* arena;
+        };
+
+        template<typename T, typename U>
+        inline bool
+        operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+        {
+            return a.arena == b.arena;
+        }
+
+        template<typename T, typename U>
+        inline bool
+        operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+        {
+            return a.arena != b.arena;
+        }
+
+        template<typename T>
+        using FrameVector = std::vector< T, ArenaAllocator<T> >;
+    }
+}
+
+#endif
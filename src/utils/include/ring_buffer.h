@@ -0,0 +1,186 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _RING_BUFFER_H_
+#define _RING_BUFFER_H_
+
+#include <iostream>
+#include <array>
+#include <vector>
+#include <stdexcept>
+
+namespace mctracker
+{
+    namespace utils
+    {
+        template<typename T, size_t N>
+        class RingBuffer
+        {
+            public:
+                /**
+                 * @brief Constructor class RingBuffer
+                 * @param _limit the number of elements kept by the buffer, it cannot exceed the capacity N
+                 */
+                RingBuffer(const size_t& _limit = N)
+                    : head(0), count(0)
+                {
+                    setLimit(_limit);
+                }
+                /**
+                 * @brief add an element, when the buffer is full the oldest one is overwritten
+                 * @param elem the element to add
+                 * @param evicted variable where the overwritten element is stored
+                 * @return true if an element has been overwritten, false otherwise
+                 */
+                bool
+                push_back(const T& elem, T& evicted)
+                {
+                    if(count == limit)
+                    {
+                        evicted = data[head];
+                        data[head] = elem;
+                        head = (head + 1) % limit;
+                        return true;
+                    }
+                    data[(head + count) % limit] = elem;
+                    ++count;
+                    return false;
+                }
+                /**
+                 * @brief add an element, when the buffer is full the oldest one is overwritten
+                 * @param elem the element to add
+                 */
+                void
+                push_back(const T& elem)
+                {
+                    T evicted;
+                    push_back(elem, evicted);
+                }
+                /**
+                 * @brief remove all the elements, no memory is released
+                 */
+                void
+                clear()
+                {
+                    head = 0;
+                    count = 0;
+                }
+                /**
+                 * @brief set the number of elements kept by the buffer, the buffer is emptied
+                 * @param _limit the number of elements, it cannot exceed the capacity N
+                 */
+                void
+                setLimit(const size_t& _limit)
+                {
+                    if(_limit == 0 || _limit > N)
+                    {
+                        throw std::invalid_argument("The limit of the ring buffer has to be in (0, capacity]");
+                    }
+                    limit = _limit;
+                    clear();
+                }
+                /**
+                 * @brief copy the elements to a vector
+                 * @return a vector containing the elements from the oldest to the newest
+                 */
+                std::vector<T>
+                toVector() const
+                {
+                    std::vector<T> elems;
+                    elems.reserve(count);
+                    for(size_t i = 0; i < count; ++i)
+                    {
+                        elems.push_back((*this)[i]);
+                    }
+                    return elems;
+                }
+            public:
+                /**
+                 * @brief access an element
+                 * @param i the index of the element, 0 is the oldest one
+                 * @return the element
+                 */
+                inline const T&
+                operator[](const size_t& i) const
+                {
+                    return data[(head + i) % limit];
+                }
+
+                /**
+                 * @brief get the oldest element
+                 * @return the element
+                 */
+                inline const T&
+                front() const
+                {
+                    return data[head];
+                }
+
+                /**
+                 * @brief get the newest element
+                 * @return the element
+                 */
+                inline const T&
+                back() const
+                {
+                    return data[(head + count - 1) % limit];
+                }
+
+                /**
+                 * @brief get the number of elements
+                 * @return the number of elements
+                 */
+                inline const size_t
+                size() const
+                {
+                    return count;
+                }
+
+                /**
+                 * @brief check if the buffer is empty
+                 * @return true if there are no elements
+                 */
+                inline const bool
+                empty() const
+                {
+                    return count == 0;
+                }
+
+                /**
+                 * @brief check if the buffer is full
+                 * @return true if the next element overwrites the oldest one
+                 */
+                inline const bool
+                full() const
+                {
+                    return count == limit;
+                }
+
+                /**
+                 * @brief get the number of elements kept by the buffer
+                 * @return the limit
+                 */
+                inline const size_t
+                getLimit() const
+                {
+                    return limit;
+                }
+
+                /**
+                 * @brief get the compile time capacity of the buffer
+                 * @return the capacity
+                 */
+                static constexpr size_t
+                capacity()
+                {
+                    return N;
+                }
+            private:
+                std::array<T, N> data;
+                size_t head, count, limit;
+        };
+    }
+}
+
+#endif
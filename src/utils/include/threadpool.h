@@ -0,0 +1,72 @@
+/*
+ * Written by Andrea Pennisi
+ */
+
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <stdexcept>
+
+namespace mctracker
+{
+    namespace utils
+    {
+        class ThreadPool
+        {
+            public:
+                /**
+                 * @brief Constructor class ThreadPool
+                 * @param threads number of worker threads
+                 */
+                ThreadPool(const uint& threads);
+                /**
+                 * @brief Destructor class ThreadPool: the pending tasks are completed before joining the workers
+                 */
+                ~ThreadPool();
+                /**
+                 * @brief add a task to the queue
+                 * @param f the task to execute
+                 * @return a std::future containing the result of the task
+                 */
+                template<class F>
+                auto enqueue(F&& f) -> std::future<decltype(f())>
+                {
+                    typedef decltype(f()) Result;
+                    auto task = std::make_shared< std::packaged_task<Result()> >(std::forward<F>(f));
+                    std::future<Result> result = task->get_future();
+                    {
+                        std::unique_lock<std::mutex> lock(mtx);
+                        if(stop)
+                        {
+                            throw std::runtime_error("Enqueue on a stopped ThreadPool");
+                        }
+                        tasks.emplace([task]() { (*task)(); });
+                    }
+                    condition.notify_one();
+                    return result;
+                }
+            private:
+                /**
+                 * @brief loop executed by each worker
+                 */
+                void worker();
+            private:
+                std::vector<std::thread> workers;
+                std::queue< std::function<void()> > tasks;
+                std::mutex mtx;
+                std::condition_variable condition;
+                bool stop;
+        };
+    }
+}
+
+#endif
@@ -34,6 +34,17 @@ namespace mctracker
                 static std::vector<std::vector<Detection> > dets2Obs(const std::vector< std::vector<bbox_t> >& detections,
                         const std::vector<cv::Mat>& frames, const std::vector<cv::Mat>& masks, const std::vector<Camera>& streams);
                 
+                /**
+                 * @brief convert the detections of type bbox_t coming from the detector of a single camera into type Detection
+                 * @param detections a vector of type bbox_t coming from the detector
+                 * @param frame the frame grabbed from the camera
+                 * @param mask the foreground mask (if any) of the frame
+                 * @param stream the camera
+                 * @return a vector of type Detection compatible with the tracker format
+                 */
+                static std::vector<Detection> dets2Obs(const std::vector<bbox_t>& detections, const cv::Mat& frame, 
+                        const cv::Mat& mask, const Camera& stream);
+                
                 /**
                  * @brief make a mosaic between a set of images
                  * @param images a set of images
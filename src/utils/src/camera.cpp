@@ -4,8 +4,9 @@ using namespace mctracker;
 using namespace mctracker::utils;
 
 Camera
-::Camera(const std::string& stream, const std::string& view, const std::string& homography_file,  bool prox)
-    : proximity(prox)
+::Camera(const std::string& stream, const std::string& view, const std::string& homography_file,  bool prox, 
+         const cv::Size& size, const std::string& format)
+    : sx(1.), sy(1.), gray(format == "GRAY"), retrieved(false), lutStep(4), proximity(prox)
 {
     cap.open(stream);
     if(!cap.isOpened())
@@ -13,6 +14,9 @@ Camera
         throw std::invalid_argument("Invalid Stream File: " + stream);
     }
     
+    nativeSize = cv::Size(cap.get(cv::CAP_PROP_FRAME_WIDTH), cap.get(cv::CAP_PROP_FRAME_HEIGHT));
+    set_resolution(size);
+    
     try
     {
         image_view = cv::imread(view, cv::IMREAD_GRAYSCALE);
@@ -33,24 +37,211 @@ Camera
     }
     
     Hinv = H.inv();
+    
+    std::copy(H.begin<double>(), H.end<double>(), h);
+    std::copy(Hinv.begin<double>(), Hinv.end<double>(), h_inv);
+    
+    //if the intrinsics are available the homography maps the undistorted image to the ground plane
+    if(homographyReader.keyExists("CameraMatrix"))
+    {
+        std::vector<double> coeffs;
+        if(!homographyReader.getElem("CameraMatrix", K, CV_64FC1) || 
+            !homographyReader.getElem("DistCoeffs", coeffs))
+        {
+            throw std::invalid_argument("Invalid camera intrinsics in: " + homography_file);
+        }
+        distCoeffs = cv::Mat(coeffs, true);
+        
+        if(!homographyReader.getElem("LutStep", lutStep) || lutStep < 1)
+        {
+            lutStep = 4;
+        }
+        
+        build_lut(nativeSize);
+    }
+}
+
+void 
+Camera::set_resolution(const cv::Size& size)
+{
+    resolution = nativeSize;
+    if(size.area() == 0 || size == nativeSize)
+    {
+        return;
+    }
+    
+    //devices and some backends (e.g. gstreamer) can decode directly at the requested size
+    cap.set(cv::CAP_PROP_FRAME_WIDTH, size.width);
+    cap.set(cv::CAP_PROP_FRAME_HEIGHT, size.height);
+    
+    resolution = size;
+    sx = float(nativeSize.width) / resolution.width;
+    sy = float(nativeSize.height) / resolution.height;
+}
+
+void 
+Camera::build_lut(const cv::Size& size)
+{
+    const int& cols = (size.width + lutStep - 1) / lutStep + 1;
+    const int& rows = (size.height + lutStep - 1) / lutStep + 1;
+    
+    std::vector<cv::Point2f> nodes;
+    for(auto i = 0; i < rows; ++i)
+    {
+        for(auto j = 0; j < cols; ++j)
+        {
+            nodes.push_back(cv::Point2f(j * lutStep, i * lutStep));
+        }
+    }
+    
+    std::vector<cv::Point2f> worldNodes;
+    undistort2world(nodes, worldNodes);
+    lut = cv::Mat(worldNodes, true).reshape(2, rows);
 }
 
 bool 
-Camera::getFrame(cv::Mat& frame)
+Camera::lookup(const cv::Point2f& p, cv::Point2f& world) const
 {
-    cap >> frame;
-    if(frame.empty())
+    const float& gx = p.x / lutStep;
+    const float& gy = p.y / lutStep;
+    
+    if(gx < 0 || gy < 0 || gx > lut.cols - 1 || gy > lut.rows - 1)
     {
         return false;
     }
+    
+    const int& x0 = std::min(int(gx), lut.cols - 2);
+    const int& y0 = std::min(int(gy), lut.rows - 2);
+    const float& ax = gx - x0;
+    const float& ay = gy - y0;
+    
+    const cv::Vec2f* r0 = lut.ptr<cv::Vec2f>(y0);
+    const cv::Vec2f* r1 = lut.ptr<cv::Vec2f>(y0 + 1);
+    const cv::Vec2f& top = (1 - ax) * r0[x0] + ax * r0[x0 + 1];
+    const cv::Vec2f& bottom = (1 - ax) * r1[x0] + ax * r1[x0 + 1];
+    const cv::Vec2f& v = (1 - ay) * top + ay * bottom;
+    
+    world = cv::Point2f(v[0], v[1]);
     return true;
 }
 
+void 
+Camera::undistort2world(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& projected) const
+{
+    std::vector<cv::Point2f> undistorted;
+    if(points.size() > 0)
+    {
+        cv::undistortPoints(points, undistorted, K, distCoeffs, cv::noArray(), K);
+    }
+    mctracker::geometry::Homography::calcProjection(undistorted, h, projected);
+}
+
+void 
+Camera::distort(std::vector<cv::Point2f>& points) const
+{
+    if(points.size() == 0)
+    {
+        return;
+    }
+    
+    const double& fx = K.at<double>(0, 0);
+    const double& fy = K.at<double>(1, 1);
+    const double& cx = K.at<double>(0, 2);
+    const double& cy = K.at<double>(1, 2);
+    
+    std::vector<cv::Point3f> normalized;
+    for(const auto& p : points)
+    {
+        normalized.push_back(cv::Point3f((p.x - cx) / fx, (p.y - cy) / fy, 1.));
+    }
+    
+    const cv::Mat& zero = cv::Mat::zeros(3, 1, CV_64FC1);
+    cv::projectPoints(normalized, zero, zero, K, distCoeffs, points);
+}
+
+bool 
+Camera::getFrame(cv::Mat& frame)
+{
+    return grab() && retrieve(frame);
+}
+
+bool 
+Camera::grab()
+{
+    retrieved = false;
+    return cap.grab();
+}
+
+bool 
+Camera::retrieve(cv::Mat& frame, const bool& color)
+{
+    if(!retrieved)
+    {
+        //a new buffer is needed: the previous frames can still be used by the caller
+        decoded = cv::Mat();
+        if(!cap.retrieve(decoded) || decoded.empty())
+        {
+            return false;
+        }
+        
+        //the backend cannot scale: the frame is resized after the decoding
+        if(resolution.area() > 0 && decoded.size() != resolution)
+        {
+            cv::Mat resized;
+            cv::resize(decoded, resized, resolution, 0, 0, cv::INTER_AREA);
+            decoded = resized;
+        }
+        retrieved = true;
+    }
+    
+    //a gstreamer pipeline with GRAY8 caps decodes straight to gray, 
+    //any other backend decodes to BGR and the frame is converted here
+    if(decoded.channels() == 1)
+    {
+        if(color)
+        {
+            cv::cvtColor(decoded, frame, cv::COLOR_GRAY2BGR);
+        }
+        else
+        {
+            frame = decoded;
+        }
+    }
+    else if(gray && !color)
+    {
+        cv::cvtColor(decoded, frame, cv::COLOR_BGR2GRAY);
+    }
+    else
+    {
+        frame = decoded;
+    }
+    return true;
+}
+
+double 
+Camera::timestamp()
+{
+    return cap.get(cv::CAP_PROP_POS_MSEC) / 1000.;
+}
+
 cv::Point2f 
-Camera::camera2world(const cv::Point2f& p) const
+Camera::camera2world(const cv::Point2f& _p) const
 {
+    const cv::Point2f& p = to_native(_p);
+    if(!lut.empty())
+    {
+        cv::Point2f world;
+        if(!lookup(p, world))
+        {
+            std::vector<cv::Point2f> projected;
+            undistort2world(std::vector<cv::Point2f>(1, p), projected);
+            world = projected.at(0);
+        }
+        return world;
+    }
+    
     double x, y;
-    mctracker::geometry::Homography::calcProjection(p, H, x, y);
+    mctracker::geometry::Homography::calcProjection(p, h, x, y);
     return cv::Point2f(x, y);
 }
 
@@ -58,6 +249,65 @@ cv::Point2f
 Camera::world2camera(const cv::Point2f& p) const
 {
     double x, y;
-    mctracker::geometry::Homography::calcProjection(p, Hinv, x, y);
-    return cv::Point2f(x, y);
+    mctracker::geometry::Homography::calcProjection(p, h_inv, x, y);
+    
+    if(!K.empty())
+    {
+        std::vector<cv::Point2f> points(1, cv::Point2f(x, y));
+        distort(points);
+        return from_native(points.at(0));
+    }
+    
+    return from_native(cv::Point2f(x, y));
+}
+
+void 
+Camera::camera2world(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& projected) const
+{
+    if(!lut.empty())
+    {
+        projected.resize(points.size());
+        auto i = 0;
+        for(const auto& p : points)
+        {
+            if(!lookup(to_native(p), projected.at(i)))
+            {
+                projected.at(i) = camera2world(p);
+            }
+            ++i;
+        }
+        return;
+    }
+    
+    if(resolution != nativeSize)
+    {
+        std::vector<cv::Point2f> native;
+        for(const auto& p : points)
+        {
+            native.push_back(to_native(p));
+        }
+        mctracker::geometry::Homography::calcProjection(native, h, projected);
+        return;
+    }
+    
+    mctracker::geometry::Homography::calcProjection(points, h, projected);
+}
+
+void 
+Camera::world2camera(const std::vector<cv::Point2f>& points, std::vector<cv::Point2f>& projected) const
+{
+    mctracker::geometry::Homography::calcProjection(points, h_inv, projected);
+    
+    if(!K.empty())
+    {
+        distort(projected);
+    }
+    
+    if(resolution != nativeSize)
+    {
+        for(auto& p : projected)
+        {
+            p = from_native(p);
+        }
+    }
 }
@@ -14,7 +14,8 @@ CameraStack::open_streams(const std::vector<CameraParam>& params)
 {
     for(const auto& param : params)
     {
-        Camera cam(param.getStream(), param.getFOV(), param.getHomography(), param.getProximity());
+        Camera cam(param.getStream(), param.getFOV(), param.getHomography(), param.getProximity(), 
+                   cv::Size(param.getWidth(), param.getHeight()), param.getFormat());
         streams.push_back(cam);
     }
 }
@@ -35,3 +36,26 @@ CameraStack::getFrame(std::vector<cv::Mat>& frames)
     }
     return true;
 }
+
+bool
+CameraStack::grab()
+{
+    for(auto& stream : streams)
+    {
+        if(!stream.grab())
+            return false;
+    }
+    return true;
+}
+
+bool
+CameraStack::retrieve(const int& camera, cv::Mat& frame, const bool& color)
+{
+    return streams.at(camera).retrieve(frame, color);
+}
+
+double
+CameraStack::timestamp(const int& camera)
+{
+    return streams.at(camera).timestamp();
+}
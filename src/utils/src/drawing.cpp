@@ -26,4 +26,20 @@ Drawing::rectangle(const cv::Rect& _rect, const cv::Scalar& color, cv::Mat& img)
     cv::rectangle(img, _rect, color, 2);
 }
 
+void 
+Drawing::box(cv::Point2f foot, const cv::Size& size, const cv::Scalar& color, const std::string& label, cv::Mat& img)
+{
+    if(size.width != 0)
+    {
+        //the box stands on the foot point
+        foot.y -= size.height;
+        foot.x -= (size.width>>1);
 
+        if(foot.x >= 0 && foot.y >= 0 && (foot.x + size.width) < (img.cols - 1) && (foot.y + size.height) < (img.rows - 1))
+        {
+            rectangle(cv::Rect(foot.x, foot.y, size.width, size.height), color, img);
+            cv::putText(img, ("#" + label).c_str(), foot, cv::FONT_HERSHEY_SIMPLEX,
+                                    0.55, cv::Scalar(0, 255, 0), 2, CV_AA);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#include "frame_arena.h"
+
+using namespace mctracker;
+using namespace mctracker::utils;
+
+FrameArena
+::FrameArena(const size_t& _blockSize)
+    : blockSize(_blockSize), current(0), offset(0), total_used(0), peak_used(0), system_allocations(0)
+{
+    add_block(blockSize);
+}
+
+void
+FrameArena::add_block(const size_t& size)
+{
+    blocks.push_back(std::unique_ptr<char[]>(new char[size]));
+    sizes.push_back(size);
+    system_allocations++;
+}
+
+void*
+FrameArena::allocate(const size_t& bytes, const size_t& alignment)
+{
+    while(true)
+    {
+        const auto& base = reinterpret_cast<uintptr_t>(blocks.at(current).get());
+        const size_t& aligned = ((base + offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+        if(aligned + bytes <= sizes.at(current))
+        {
+            offset = aligned + bytes;
+            peak_used = std::max(peak_used, total_used + offset);
+            return blocks.at(current).get() + aligned;
+        }
+
+        //the request does not fit: move to the next block, allocating it if needed
+        total_used += offset;
+        offset = 0;
+        ++current;
+        if(current == blocks.size())
+        {
+            add_block(std::max(blockSize, bytes + alignment));
+        }
+    }
+}
+
+cv::Mat
+FrameArena::mat(const int& rows, const int& cols, const int& type)
+{
+    const size_t& step = cols * CV_ELEM_SIZE(type);
+    //the matrix does not own the data: no allocation and no deallocation
+    return cv::Mat(rows, cols, type, allocate(std::max(rows * step, size_t(1)), 16), step);
+}
+
+void
+FrameArena::reset()
+{
+    //the frame needed more blocks: from now on a single block holds all the frame
+    if(blocks.size() > 1)
+    {
+        size_t total = 0;
+        for(const auto& size : sizes)
+        {
+            total += size;
+        }
+        blocks.clear();
+        sizes.clear();
+        blockSize = total;
+        add_block(blockSize);
+    }
+
+    current = 0;
+    offset = 0;
+    total_used = 0;
+}
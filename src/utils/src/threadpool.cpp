@@ -0,0 +1,48 @@
+#include "threadpool.h"
+
+using namespace mctracker;
+using namespace mctracker::utils;
+
+ThreadPool
+::ThreadPool(const uint& threads)
+    : stop(false)
+{
+    for(uint i = 0; i < std::max(threads, 1u); ++i)
+    {
+        workers.emplace_back(&ThreadPool::worker, this);
+    }
+}
+
+ThreadPool
+::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        stop = true;
+    }
+    condition.notify_all();
+    for(auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void 
+ThreadPool::worker()
+{
+    while(true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            condition.wait(lock, [this]() { return stop || !tasks.empty(); });
+            if(stop && tasks.empty())
+            {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
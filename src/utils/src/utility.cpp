@@ -10,21 +10,35 @@ Utility::dets2Obs(const std::vector< std::vector<bbox_t> >& detections,
     auto i = 0;
     for(const auto& detection : detections)
     {
-        const auto& stream = streams.at(i); 
-        std::vector<Detection> camera_det;
-        for(const auto& det : detection)
-        {
-            cv::Point2f point(det.x + (det.w >> 1), det.y + det.h);
-            const auto& worldPoint = stream.camera2world(point);
-            Detection d(worldPoint.x, worldPoint.y,  det.w, det.h, computeHist(frames.at(i), masks.at(i), det));
-            camera_det.push_back(d);
-        }
-        obs.push_back(camera_det);
+        obs.push_back(dets2Obs(detection, frames.at(i), masks.at(i), streams.at(i)));
         ++i;
     }
     return obs;
 }
 
+std::vector<Detection>
+Utility::dets2Obs(const std::vector<bbox_t>& detections, const cv::Mat& frame, const cv::Mat& mask, const Camera& stream)
+{
+    std::vector<Detection> camera_det;
+    std::vector<cv::Point2f> points, worldPoints;
+    for(const auto& det : detections)
+    {
+        points.push_back(cv::Point2f(det.x + (det.w >> 1), det.y + det.h));
+    }
+    
+    //project all the foot points of the camera at once
+    stream.camera2world(points, worldPoints);
+    
+    auto j = 0;
+    for(const auto& det : detections)
+    {
+        const auto& worldPoint = worldPoints.at(j++);
+        Detection d(worldPoint.x, worldPoint.y,  det.w, det.h, computeHist(frame, mask, det));
+        camera_det.push_back(d);
+    }
+    return camera_det;
+}
+
 cv::Mat
 Utility::makeMosaic(const std::vector<cv::Mat> &images)
 {
@@ -69,7 +83,23 @@ Utility::computeHist(const cv::Mat& img, const cv::Mat& mask, const bbox_t& d)
     cv::Mat maskPatch;
     if(!mask.empty())
     {
-        maskPatch = mask(r);
+        if(mask.size() == img.size())
+        {
+            maskPatch = mask(r);
+        }
+        else
+        {
+            //the mask is computed at a lower scale: only the patch of the box is upsampled
+            const float& sx = float(mask.cols) / img.cols;
+            const float& sy = float(mask.rows) / img.rows;
+            cv::Rect maskRect(std::floor(r.x * sx), std::floor(r.y * sy), 
+                              std::ceil(r.width * sx), std::ceil(r.height * sy));
+            maskRect &= cv::Rect(0, 0, mask.cols, mask.rows);
+            if(maskRect.area() > 0)
+            {
+                cv::resize(mask(maskRect), maskPatch, r.size(), 0, 0, cv::INTER_NEAREST);
+            }
+        }
     }
     
     cv::Mat hsvPatch;
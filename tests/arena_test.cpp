@@ -0,0 +1,74 @@
+#include <iostream>
+#include <opencv2/opencv.hpp>
+
+#include "camerastack.h"
+#include "tracker.h"
+#include "kalman_param.h"
+#include "configmanager.h"
+#include "detection_log.h"
+
+
+using namespace mctracker;
+using namespace mctracker::config;
+using namespace mctracker::utils;
+using namespace mctracker::tracker;
+
+
+auto main(int argc, char **argv) -> int
+{
+    if(argc != 3)
+    {
+        std::cout << "Usage: " << argv[0] << " /path/to/the/config/file /path/to/the/detection/log" << std::endl;
+        return 1;
+    }
+
+    ConfigManager config;
+    config.read(std::string(argv[1]));
+
+    auto param = config.getKalmanParam();
+    param.setDeterministic(true);
+    param.setDetectionLog("");
+    param.setTrajectoryLog("");
+
+    CameraStack streams(config.getCameraParam());
+    Tracker tr(param, streams.getCameraStack());
+
+    DetectionLog log;
+    log.open(std::string(argv[2]));
+
+    //the first frames size the arena, then the temporaries of a step never reach the system allocator
+    const uint warmup = 10;
+    size_t allocations = 0;
+    uint frames = 0;
+    std::vector<Detections> observations;
+    std::vector<double> timestamps;
+    int w, h;
+    while(log.read(observations, timestamps, w, h))
+    {
+        tr.setSize(w, h);
+        tr.track(observations, w, h, timestamps);
+
+        const auto& arena = tr.getArena();
+        if(++frames == warmup)
+        {
+            allocations = arena.systemAllocations();
+        }
+        else if(frames > warmup && arena.systemAllocations() != allocations)
+        {
+            std::cout << "[ARENA]: FAILED, " << arena.systemAllocations() - allocations << " new blocks at frame " << frames 
+                      << ", peak " << arena.peak() << " bytes" << std::endl;
+            return 1;
+        }
+    }
+
+    const auto& arena = tr.getArena();
+    if(frames <= warmup || arena.peak() == 0)
+    {
+        std::cout << "[ARENA]: FAILED, the replay did not use the arena" << std::endl;
+        return 1;
+    }
+
+    std::cout << "[ARENA]: PASSED, " << arena.systemAllocations() << " blocks for " << frames << " frames, peak " 
+              << arena.peak() << " bytes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+# Writes the synthetic detection log replayed by the tracker tests: people walking in the plan view of the
+# two cameras of configs/config.yaml, with crossings, an occlusion, missed detections and late frames
+# of the second camera. The file has the DetectionLog format of src/tracker/src/detection_log.cpp.
+import math
+import random
+import struct
+import sys
+
+FRAMES = 100
+FPS = 7.
+WIDTH, HEIGHT = 1246, 1100
+HIST_ROWS, HIST_COLS = 6, 8
+CV_32FC1 = 5
+
+#start, end, box size, histogram peak, occluded frames
+WALKERS = [
+    ((600, 700), (980, 760), (40, 110), (1, 2), ()),
+    ((980, 640), (620, 720), (38, 105), (4, 6), ()),
+    ((900, 980), (960, 760), (42, 115), (2, 5), ()),
+    ((700, 950), (720, 600), (36, 100), (5, 1), range(41, 66)),
+]
+
+#rough box inside the field of view of the second camera
+CAMERA2 = (870, 720, 1030, 980)
+
+
+def histogram(peak, rng):
+    values = []
+    for i in range(HIST_ROWS):
+        for j in range(HIST_COLS):
+            d = (i - peak[0]) ** 2 + (j - peak[1]) ** 2
+            values.append(math.exp(-d / 2.) + rng.uniform(0, .05))
+    top = max(values)
+    return [v / top for v in values]
+
+
+def detection(p, size, peak, rng):
+    data = struct.pack('<ffff', p[0] + rng.gauss(0, 1.5), p[1] + rng.gauss(0, 1.5), size[0], size[1])
+    data += struct.pack('<iii', HIST_ROWS, HIST_COLS, CV_32FC1)
+    data += struct.pack('<%df' % (HIST_ROWS * HIST_COLS), *histogram(peak, rng))
+    return data
+
+
+def main(path):
+    rng = random.Random(2024)
+    out = bytearray(struct.pack('<I', 0x5344434d))
+    for f in range(FRAMES):
+        t = f / FPS
+        #the second camera delivers some frames late
+        timestamps = [t, t - 2. / FPS if f % 10 == 9 else t]
+        cameras = [[], []]
+        for start, end, size, peak, occluded in WALKERS:
+            a = f / (FRAMES - 1.)
+            p = (start[0] + a * (end[0] - start[0]), start[1] + a * (end[1] - start[1]))
+            if f in occluded:
+                continue
+            if rng.random() > .05:
+                cameras[0].append(detection(p, size, peak, rng))
+            if CAMERA2[0] <= p[0] <= CAMERA2[2] and CAMERA2[1] <= p[1] <= CAMERA2[3] and rng.random() > .05:
+                cameras[1].append(detection((p[0] + 3, p[1] - 2), size, peak, rng))
+
+        out += struct.pack('<iiI', WIDTH, HEIGHT, len(timestamps))
+        out += struct.pack('<%dd' % len(timestamps), *timestamps)
+        out += struct.pack('<I', len(cameras))
+        for dets in cameras:
+            out += struct.pack('<I', len(dets))
+            for d in dets:
+                out += d
+
+    with open(path, 'wb') as f:
+        f.write(out)
+
+
+if __name__ == '__main__':
+    main(sys.argv[1] if len(sys.argv) > 1 else 'walkers.bin')
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#include "hnsw_index.h"
+
+
+using namespace mctracker::tracker;
+
+typedef Appearance::Descriptor Descriptor;
+
+//zero mean and unit norm, as Appearance::describe gives them
+static void normalize(Descriptor& d)
+{
+    float mean = 0;
+    for(const auto& v : d) mean += v;
+    mean /= d.size();
+    float norm = 0;
+    for(auto& v : d)
+    {
+        v -= mean;
+        norm += v * v;
+    }
+    norm = std::sqrt(norm);
+    for(auto& v : d) v /= norm;
+}
+
+//appearances of people: a few clothing colours, each worn by many people with small changes
+static std::vector<Descriptor> appearances(const uint& n, const uint& groups, std::mt19937& rng)
+{
+    std::normal_distribution<float> noise(0., 1.);
+    std::vector<Descriptor> centers(groups);
+    for(auto& c : centers)
+    {
+        for(auto& v : c) v = noise(rng);
+    }
+
+    std::vector<Descriptor> descriptors(n);
+    for(uint i = 0; i < n; ++i)
+    {
+        const auto& c = centers.at(i % groups);
+        for(uint k = 0; k < Appearance::size; ++k)
+        {
+            descriptors.at(i)[k] = c[k] + noise(rng);
+        }
+        normalize(descriptors.at(i));
+    }
+    return descriptors;
+}
+
+
+auto main() -> int
+{
+    //the default parameters of kalman_param.yaml and a detection compared with 4 frozen tracks
+    const uint tracks = 2000, queries = 200, k = 4;
+    const uint links = 8, efConstruction = 64, efSearch = 32;
+    const float min_recall = .9;
+
+    std::mt19937 rng(2024);
+    const auto& descriptors = appearances(tracks, 50, rng);
+    HnswIndex index(links, efConstruction, efSearch);
+    for(uint i = 0; i < tracks; ++i)
+    {
+        index.insert(i, descriptors.at(i));
+    }
+
+    //half of the tracks are removed, as when the frozen tracks are restored or deleted
+    for(uint i = 0; i < tracks; i += 2)
+    {
+        index.erase(i);
+    }
+
+    //the queries are new detections of the remaining tracks
+    std::normal_distribution<float> noise(0., .1);
+    std::vector<Descriptor> targets(queries);
+    for(uint q = 0; q < queries; ++q)
+    {
+        targets.at(q) = descriptors.at(2 * (q * 7 % (tracks / 2)) + 1);
+        for(auto& v : targets.at(q)) v += noise(rng);
+        normalize(targets.at(q));
+    }
+
+    uint found = 0;
+    std::vector<HnswIndex::Neighbor> results, exact;
+    double annTime = 0, bruteTime = 0;
+    for(const auto& q : targets)
+    {
+        auto start = std::chrono::steady_clock::now();
+        index.search(q, k, results);
+        annTime += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        exact.clear();
+        for(uint i = 1; i < tracks; i += 2)
+        {
+            exact.push_back(HnswIndex::Neighbor(1.f - Appearance::similarity(q, descriptors.at(i)), i));
+        }
+        std::partial_sort(exact.begin(), exact.begin() + k, exact.end());
+        bruteTime += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        for(uint n = 0; n < k; ++n)
+        {
+            for(const auto& r : results)
+            {
+                if(r.second == exact.at(n).second)
+                {
+                    found++;
+                    break;
+                }
+            }
+        }
+    }
+
+    const float& recall = float(found) / (queries * k);
+    std::cout << "[INDEXED]: " << index.size() << std::endl;
+    std::cout << "[RECALL@" << k << "]: " << recall << std::endl;
+    std::cout << "[ANN QUERY]: " << annTime / queries << " us" << std::endl;
+    std::cout << "[BRUTE FORCE QUERY]: " << bruteTime / queries << " us" << std::endl;
+
+    if(recall < min_recall)
+    {
+        std::cout << "The recall is lower than " << min_recall << std::endl;
+        return 1;
+    }
+    return 0;
+}
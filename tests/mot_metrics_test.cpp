@@ -0,0 +1,53 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include "mot_metrics.h"
+
+
+using namespace mctracker::tracker;
+
+static TrajectoryRecord record(const int& label, const uint& frame, const float& x, const float& y)
+{
+    TrajectoryRecord r;
+    r.label = label;
+    r.frame = frame;
+    r.x = x;
+    r.y = y;
+    return r;
+}
+
+static bool check(const std::string& name, const double& value, const double& expected)
+{
+    if(std::fabs(value - expected) > 1e-6)
+    {
+        std::cout << name << ": " << value << " instead of " << expected << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+auto main() -> int
+{
+    //two objects on the plan view, the first one is taken over by a new track in frame 2,
+    //frame 2 has a false positive and the second object is missed in frame 3
+    MotMetrics metrics(10.);
+    metrics.update({record(1, 0, 0, 0), record(2, 0, 100, 0)}, {record(10, 0, 3, 4), record(20, 0, 100, 0)});
+    metrics.update({record(1, 1, 0, 0), record(2, 1, 100, 0)}, {record(10, 1, 0, 0), record(20, 1, 100, 0)});
+    metrics.update({record(1, 2, 0, 0), record(2, 2, 100, 0)}, {record(30, 2, 0, 0), record(20, 2, 100, 0), record(40, 2, 500, 500)});
+    metrics.update({record(1, 3, 0, 0), record(2, 3, 100, 0)}, {record(30, 3, 0, 0)});
+    metrics.finalize();
+
+    //8 objects, 1 miss, 1 false positive and 1 switch
+    bool ok = check("switches", metrics.switches(), 1);
+    ok &= check("mota", metrics.mota(), 1. - 3. / 8.);
+    //7 matches, the only non zero distance is the 3-4-5 one of frame 0
+    ok &= check("motp", metrics.motp(), 5. / 7.);
+    //the best identity assignment is 1 -> 10 (2 frames) and 2 -> 20 (3 frames), over 8 objects and 8 tracks
+    ok &= check("idf1", metrics.idf1(), 2. * 5. / 16.);
+
+    metrics.toJson(std::cout);
+    std::cout << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,12 @@
+# Replays a detection log twice: the second run has to reproduce the output of the first one bit for bit.
+# cmake -DREPLAY=<tracker_replay> -DCONFIG=<config> -DSTREAM=<detection log> -DOUTPUT=<output> -P replay.cmake
+
+execute_process(COMMAND ${REPLAY} ${CONFIG} ${STREAM} ${OUTPUT} --record RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "The replay of ${STREAM} failed")
+endif()
+
+execute_process(COMMAND ${REPLAY} ${CONFIG} ${STREAM} ${OUTPUT} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Two replays of ${STREAM} give different tracks")
+endif()